@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace Bench
+{
+
+//resets VmHWM of the current process (linux >= 4.0)
+inline void reset_peak_rss()
+{
+    std::ofstream clear_refs {"/proc/self/clear_refs"};
+    clear_refs << "5";
+}
+
+inline double peak_rss_mb()
+{
+    std::ifstream status {"/proc/self/status"};
+    std::string key;
+    while (status >> key)
+    {
+        if (key == "VmHWM:")
+        {
+            std::size_t kb = 0;
+            status >> kb;
+            return kb / 1024.0;
+        }
+        status.ignore(256, '\n');
+    }
+    return 0;
+}
+
+} // namespace Bench
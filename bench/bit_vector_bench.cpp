@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include "bit_vector.hpp"
+
+namespace
+{
+
+template<typename Bits>
+Bits random_bits(std::size_t size, unsigned seed)
+{
+    std::mt19937 gen {seed};
+    Bits bits;
+    for (std::size_t i = 0; i < size; i++)
+        bits.push_back(gen() % 4 == 0);
+    return bits;
+}
+
+//a filter combining two bitmaps and counting the matches, with a byte per flag and packed
+void BM_Filter_VectorBool(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto lhs = random_bits<Container::Vector<bool>>(size, 1), rhs = random_bits<Container::Vector<bool>>(size, 2);
+    Container::Vector<bool> result (size);
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < size; i++)
+        {
+            result[i] = lhs[i] && !rhs[i];
+            count += result[i];
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+void BM_Filter_BitVector(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto lhs = random_bits<Container::BitVector>(size, 1), rhs = random_bits<Container::BitVector>(size, 2);
+    Container::BitVector result (size);
+    for (auto _ : state)
+    {
+        result = lhs;
+        result.and_not(rhs);
+        benchmark::DoNotOptimize(result.count());
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+void BM_Popcount(benchmark::State& state)
+{
+    auto isa = static_cast<Container::Numeric::Isa>(state.range(0));
+    if (!Container::Numeric::supported(isa))
+        return state.SkipWithError("instruction set is not supported by this CPU");
+    auto kernel = Container::popcount_kernel(isa);
+    auto bits = random_bits<Container::BitVector>(1 << 20, 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(kernel(bits.data(), bits.words().size()));
+    state.SetBytesProcessed(state.iterations() * bits.words().size_bytes());
+}
+
+void BM_Rank(benchmark::State& state)
+{
+    auto bits = random_bits<Container::BitVector>(1 << 24, 4);
+    Container::RankSelect index {bits};
+    std::size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(index.rank1(i++ * 7919 % bits.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Select(benchmark::State& state)
+{
+    auto bits = random_bits<Container::BitVector>(1 << 24, 5);
+    Container::RankSelect index {bits};
+    std::size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(index.select1(i++ * 7919 % index.ones()));
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_Filter_VectorBool)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_Filter_BitVector)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+//0 scalar, 1 popcnt, 2 avx2, 3 avx512
+BENCHMARK(BM_Popcount)->DenseRange(0, 3);
+BENCHMARK(BM_Rank);
+BENCHMARK(BM_Select);
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "vector.hpp"
+#include "concurrent_vector.hpp"
+
+namespace
+{
+
+//what the workers did before: one Vector behind a mutex
+struct LockedVector
+{
+    std::mutex mutex;
+    Container::Vector<std::uint64_t> vec;
+
+    void push_back(std::uint64_t val)
+    {
+        std::lock_guard lock {mutex};
+        vec.push_back(val);
+    }
+};
+
+using ConcurrentVector = Container::ConcurrentVector<std::uint64_t>;
+
+//every thread appends to one shared vector; the start and the end of the loop are barriers,
+//so thread 0 owns setup and teardown
+template<typename Vec>
+void BM_ConcurrentPushBack(benchmark::State& state)
+{
+    static std::unique_ptr<Vec> shared;
+    if (state.thread_index() == 0)
+        shared = std::make_unique<Vec>();
+
+    std::uint64_t val = state.thread_index();
+    for (auto _ : state)
+        shared->push_back(val++);
+
+    if (state.thread_index() == 0)
+        shared.reset();
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ConcurrentPushBack, LockedVector)->ThreadRange(1, 64)->Iterations(1 << 18)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentPushBack, ConcurrentVector)->ThreadRange(1, 64)->Iterations(1 << 18)->UseRealTime();
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "vector.hpp"
+
+namespace
+{
+
+using Vec = Container::Vector<std::uint8_t>;
+
+//std::copy and std::equal on Vector iterators, which libstdc++ only turns into memmove/memcmp for raw pointers,
+//against the Ranges versions that unwrap contiguous iterators and against the raw calls on data()
+void BM_StdCopy(benchmark::State& state)
+{
+    Vec src (static_cast<std::size_t>(state.range(0)), 1), dst (src.size());
+    for (auto _ : state)
+    {
+        std::copy(src.begin(), src.end(), dst.begin());
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * src.size());
+}
+
+void BM_RangesCopy(benchmark::State& state)
+{
+    Vec src (static_cast<std::size_t>(state.range(0)), 1), dst (src.size());
+    for (auto _ : state)
+    {
+        Ranges::copy(src.begin(), src.end(), dst.begin());
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * src.size());
+}
+
+void BM_Memmove(benchmark::State& state)
+{
+    Vec src (static_cast<std::size_t>(state.range(0)), 1), dst (src.size());
+    for (auto _ : state)
+    {
+        std::memmove(dst.data(), src.data(), src.size());
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * src.size());
+}
+
+void BM_StdEqual(benchmark::State& state)
+{
+    Vec lhs (static_cast<std::size_t>(state.range(0)), 1), rhs (lhs);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+    state.SetBytesProcessed(state.iterations() * lhs.size());
+}
+
+void BM_RangesEqual(benchmark::State& state)
+{
+    Vec lhs (static_cast<std::size_t>(state.range(0)), 1), rhs (lhs);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Ranges::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+    state.SetBytesProcessed(state.iterations() * lhs.size());
+}
+
+void BM_Memcmp(benchmark::State& state)
+{
+    Vec lhs (static_cast<std::size_t>(state.range(0)), 1), rhs (lhs);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::memcmp(lhs.data(), rhs.data(), lhs.size()));
+    state.SetBytesProcessed(state.iterations() * lhs.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_StdCopy)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_RangesCopy)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_Memmove)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_StdEqual)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_RangesEqual)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_Memcmp)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "bench_utils.hpp"
+#include "vector.hpp"
+#include "remap_allocator.hpp"
+
+namespace
+{
+
+using DefaultVector = Container::Vector<std::uint64_t>;
+using RemapVector   = Container::Vector<std::uint64_t, Container::RemapAllocator<std::uint64_t>>;
+using StdVector     = std::vector<std::uint64_t>;
+
+template<typename Vec>
+void BM_GrowthPushBack(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Bench::reset_peak_rss();
+        state.ResumeTiming();
+
+        Vec vec {};
+        for (std::size_t i = 0; i < n; i++)
+            vec.push_back(i);
+        benchmark::DoNotOptimize(vec.data());
+
+        state.PauseTiming();
+        state.counters["peak_rss_mb"] = Bench::peak_rss_mb();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+//one doubling step of a filled buffer: the copy and the transient peak of old + new block
+template<typename Vec>
+void BM_GrowthReserve(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Vec vec (n, 1);
+        Bench::reset_peak_rss();
+        state.ResumeTiming();
+
+        vec.reserve(2 * n);
+        benchmark::DoNotOptimize(vec.data());
+
+        state.PauseTiming();
+        state.counters["peak_rss_mb"] = Bench::peak_rss_mb();
+        vec = Vec{};
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint64_t));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_GrowthPushBack, StdVector)->RangeMultiplier(8)->Range(1 << 14, 1 << 26)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GrowthPushBack, DefaultVector)->RangeMultiplier(8)->Range(1 << 14, 1 << 26)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GrowthPushBack, RemapVector)->RangeMultiplier(8)->Range(1 << 14, 1 << 26)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_GrowthReserve, DefaultVector)->RangeMultiplier(8)->Range(1 << 14, 1 << 26)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GrowthReserve, RemapVector)->RangeMultiplier(8)->Range(1 << 14, 1 << 26)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "vector.hpp"
+#include "malloc_allocator.hpp"
+
+namespace
+{
+
+template<typename Policy>
+using PolicyVector = Container::Vector<std::uint64_t, Container::MallocAllocator<std::uint64_t>, Policy>;
+
+//reports reallocations and the unused capacity, both at the end and averaged over every size reached
+template<typename Vec>
+void BM_GrowthPolicy(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    std::size_t reallocations = 0;
+    double final_overhead = 0, mean_overhead = 0;
+    for (auto _ : state)
+    {
+        Vec vec {};
+        reallocations = 0;
+        mean_overhead = 0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            auto capacity = vec.capacity();
+            vec.push_back(i);
+            reallocations += (capacity != vec.capacity());
+            mean_overhead += static_cast<double>(vec.capacity() - vec.size()) / vec.size();
+        }
+        benchmark::DoNotOptimize(vec.data());
+        final_overhead = static_cast<double>(vec.capacity() - vec.size()) / vec.size();
+    }
+    state.counters["reallocs"] = reallocations;
+    state.counters["overhead_pct"] = 100 * final_overhead;
+    state.counters["mean_overhead_pct"] = 100 * mean_overhead / n;
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+using Doubling    = PolicyVector<Container::Growth::Doubling>;
+using OneAndHalf  = PolicyVector<Container::Growth::OneAndHalf>;
+using PageRounded = PolicyVector<Container::Growth::PageRounded<>>;
+using UsableSize  = PolicyVector<Container::Growth::UsableSize<>>;
+using UsableSizeOneAndHalf = PolicyVector<Container::Growth::UsableSize<Container::Growth::OneAndHalf>>;
+
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, Doubling)->Arg(100)->Arg(1000)->Arg(100000)->Arg(5000000);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, OneAndHalf)->Arg(100)->Arg(1000)->Arg(100000)->Arg(5000000);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, PageRounded)->Arg(100)->Arg(1000)->Arg(100000)->Arg(5000000);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, UsableSize)->Arg(100)->Arg(1000)->Arg(100000)->Arg(5000000);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, UsableSizeOneAndHalf)->Arg(100)->Arg(1000)->Arg(100000)->Arg(5000000);
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "vector.hpp"
+#include "huge_page_allocator.hpp"
+
+namespace
+{
+
+using DefaultVector  = Container::Vector<std::uint64_t>;
+using HugePageVector = Container::Vector<std::uint64_t, Container::HugePageAllocator<std::uint64_t>>;
+
+//dependent random reads over the whole buffer, so every access pays a TLB and cache miss
+template<typename Vec>
+void BM_RandomAccess(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    Vec vec (n);
+    //single cycle permutation (Sattolo), so the chase visits every element
+    for (std::size_t i = 0; i < n; i++)
+        vec[i] = i;
+    std::uint64_t rng = 88172645463325252ull;
+    for (std::size_t i = n - 1; i > 0; i--)
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        std::swap(vec[i], vec[rng % i]);
+    }
+
+    constexpr std::size_t steps = 1 << 20;
+    std::uint64_t pos = 0;
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < steps; i++)
+            pos = vec[pos];
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetItemsProcessed(state.iterations() * steps);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_RandomAccess, DefaultVector)->RangeMultiplier(8)->Range(1 << 20, 1 << 26)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RandomAccess, HugePageVector)->RangeMultiplier(8)->Range(1 << 20, 1 << 26)->Unit(benchmark::kMillisecond);
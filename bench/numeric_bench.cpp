@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include "numeric.hpp"
+
+namespace
+{
+
+using Vec = Container::Vector<float>;
+using Container::Numeric::Isa;
+
+Vec make_input(std::size_t n, float scale)
+{
+    Vec vec (n);
+    for (std::size_t i = 0; i < n; i++)
+        vec[i] = static_cast<float>(i % 1000) * scale;
+    return vec;
+}
+
+//a = b * c + d written as one loop per operation, with a temporary Vector
+void BM_NaiveExpression(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    auto b = make_input(n, 0.5f), c = make_input(n, 0.25f), d = make_input(n, 2.0f);
+    Vec a (n);
+    for (auto _ : state)
+    {
+        Vec tmp (n);
+        for (std::size_t i = 0; i < n; i++)
+            tmp[i] = b[i] * c[i];
+        for (std::size_t i = 0; i < n; i++)
+            a[i] = tmp[i] + d[i];
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_FusedExpression(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    auto b = make_input(n, 0.5f), c = make_input(n, 0.25f), d = make_input(n, 2.0f);
+    Vec a (n);
+    for (auto _ : state)
+    {
+        Container::Numeric::assign(a, b * c + d);
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_NaiveSum(benchmark::State& state)
+{
+    auto vec = make_input(static_cast<std::size_t>(state.range(0)), 0.5f);
+    for (auto _ : state)
+    {
+        float sum = 0;
+        for (auto val : vec)
+            sum += val;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * vec.size());
+}
+
+void BM_NaiveDot(benchmark::State& state)
+{
+    auto lhs = make_input(static_cast<std::size_t>(state.range(0)), 0.5f), rhs = make_input(lhs.size(), 0.25f);
+    for (auto _ : state)
+    {
+        float dot = 0;
+        for (std::size_t i = 0; i < lhs.size(); i++)
+            dot += lhs[i] * rhs[i];
+        benchmark::DoNotOptimize(dot);
+    }
+    state.SetItemsProcessed(state.iterations() * lhs.size());
+}
+
+void BM_NaiveMax(benchmark::State& state)
+{
+    auto vec = make_input(static_cast<std::size_t>(state.range(0)), 0.5f);
+    for (auto _ : state)
+    {
+        float max = vec[0];
+        for (auto val : vec)
+            max = max < val ? val : max;
+        benchmark::DoNotOptimize(max);
+    }
+    state.SetItemsProcessed(state.iterations() * vec.size());
+}
+
+//one run per instruction set, unsupported ones are skipped
+template<Isa isa>
+void BM_KernelSum(benchmark::State& state)
+{
+    if (!Container::Numeric::supported(isa))
+        return state.SkipWithError("instruction set is not supported");
+    auto& kernels = Container::Numeric::kernels<float>(isa);
+    auto vec = make_input(static_cast<std::size_t>(state.range(0)), 0.5f);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(kernels.sum(vec.data(), vec.size()));
+    state.SetItemsProcessed(state.iterations() * vec.size());
+}
+
+template<Isa isa>
+void BM_KernelDot(benchmark::State& state)
+{
+    if (!Container::Numeric::supported(isa))
+        return state.SkipWithError("instruction set is not supported");
+    auto& kernels = Container::Numeric::kernels<float>(isa);
+    auto lhs = make_input(static_cast<std::size_t>(state.range(0)), 0.5f), rhs = make_input(lhs.size(), 0.25f);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(kernels.dot(lhs.data(), rhs.data(), lhs.size()));
+    state.SetItemsProcessed(state.iterations() * lhs.size());
+}
+
+template<Isa isa>
+void BM_KernelMax(benchmark::State& state)
+{
+    if (!Container::Numeric::supported(isa))
+        return state.SkipWithError("instruction set is not supported");
+    auto& kernels = Container::Numeric::kernels<float>(isa);
+    auto vec = make_input(static_cast<std::size_t>(state.range(0)), 0.5f);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(kernels.max(vec.data(), vec.size()));
+    state.SetItemsProcessed(state.iterations() * vec.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_NaiveExpression)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_FusedExpression)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+
+BENCHMARK(BM_NaiveSum)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelSum, Isa::sse2)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelSum, Isa::avx2)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelSum, Isa::avx512)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+BENCHMARK(BM_NaiveDot)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelDot, Isa::sse2)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelDot, Isa::avx2)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelDot, Isa::avx512)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+BENCHMARK(BM_NaiveMax)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelMax, Isa::sse2)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelMax, Isa::avx2)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_KernelMax, Isa::avx512)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
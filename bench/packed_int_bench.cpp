@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include "packed_int_vector.hpp"
+
+namespace
+{
+
+constexpr std::size_t table_size = 1 << 22;
+
+//values of the given bit width above a large common offset, like ids or timestamps
+Container::Vector<std::uint64_t> make_values(std::size_t size, unsigned width)
+{
+    std::mt19937_64 gen {7};
+    Container::Vector<std::uint64_t> values;
+    values.reserve(size);
+    for (std::size_t i = 0; i < size; i++)
+        values.push_back((std::uint64_t{1} << 40) + (gen() & Container::detail::low_bits(width)));
+    return values;
+}
+
+//the plain table streamed into another buffer, what decoding competes with
+void BM_Decode_Plain(benchmark::State& state)
+{
+    auto values = make_values(table_size, 64);
+    Container::Vector<std::uint64_t> out (table_size, Container::default_init);
+    for (auto _ : state)
+    {
+        Ranges::copy(values.begin(), values.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * table_size);
+    state.counters["bytes_per_value"] = sizeof(std::uint64_t);
+}
+
+void BM_Decode_Packed(benchmark::State& state)
+{
+    auto isa = static_cast<Container::Numeric::Isa>(state.range(0));
+    auto width = static_cast<unsigned>(state.range(1));
+    if (!Container::Numeric::supported(isa))
+        return state.SkipWithError("instruction set is not supported by this CPU");
+    auto kernel = Container::unpack_kernel(isa);
+
+    auto values = make_values(table_size, width);
+    Container::PackedIntVector<std::uint64_t> packed {values};
+    Container::Vector<std::uint64_t> out (table_size, Container::default_init);
+    for (auto _ : state)
+    {
+        packed.decode(0, {out.data(), out.size()}, kernel);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * table_size);
+    state.counters["bytes_per_value"] = static_cast<double>(packed.memory_bytes()) / table_size;
+}
+
+template<typename Table>
+void random_access(benchmark::State& state, const Table& table)
+{
+    std::size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(table[i++ * 7919 % table_size]);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RandomAccess_Plain(benchmark::State& state)
+{
+    random_access(state, make_values(table_size, static_cast<unsigned>(state.range(0))));
+}
+
+void BM_RandomAccess_Packed(benchmark::State& state)
+{
+    auto values = make_values(table_size, static_cast<unsigned>(state.range(0)));
+    random_access(state, Container::PackedIntVector<std::uint64_t>{values});
+}
+
+} // namespace
+
+BENCHMARK(BM_Decode_Plain);
+//isa: 0 scalar, 2 avx2, 3 avx512; bit widths of the deltas
+BENCHMARK(BM_Decode_Packed)->ArgsProduct({{0, 2, 3}, {4, 12, 20, 33}});
+BENCHMARK(BM_RandomAccess_Plain)->Arg(12)->Arg(20);
+BENCHMARK(BM_RandomAccess_Packed)->Arg(12)->Arg(20);
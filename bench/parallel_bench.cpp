@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "vector.hpp"
+#include "parallel_ranges.hpp"
+
+namespace
+{
+
+using Vec = Container::Vector<std::uint64_t>;
+
+void BM_FillConstruct(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vec vec (n, 42);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint64_t));
+}
+
+void BM_ParallelFillConstruct(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vec vec (Container::par, n, 42);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint64_t));
+    state.counters["threads"] = Container::ThreadPool::instance().size() + 1;
+}
+
+void BM_CopyConstruct(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    Vec src (n, 42);
+    for (auto _ : state)
+    {
+        Vec vec (src);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint64_t));
+}
+
+void BM_ParallelCopyConstruct(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    Vec src (n, 42);
+    for (auto _ : state)
+    {
+        Vec vec (Container::par, src);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint64_t));
+    state.counters["threads"] = Container::ThreadPool::instance().size() + 1;
+}
+
+} // namespace
+
+BENCHMARK(BM_FillConstruct)->RangeMultiplier(16)->Range(1 << 16, 1 << 26)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelFillConstruct)->RangeMultiplier(16)->Range(1 << 16, 1 << 26)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_CopyConstruct)->RangeMultiplier(16)->Range(1 << 16, 1 << 26)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelCopyConstruct)->RangeMultiplier(16)->Range(1 << 16, 1 << 26)->Unit(benchmark::kMillisecond)->UseRealTime();
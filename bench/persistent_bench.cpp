@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include "persistent_vector.hpp"
+
+namespace
+{
+
+//keeping every version of a vector while changing one element: a Vector has to be copied per version
+void BM_VersionedSet_VectorCopy(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    Container::Vector<std::uint64_t> current (size, 1);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto next = current;
+        next[i * 7919 % size] = i + 1;
+        i++;
+        current.swap(next);
+        benchmark::DoNotOptimize(next.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_VersionedSet_Persistent(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    Container::PersistentVector<std::uint64_t> current {Container::Vector<std::uint64_t>(size, 1)};
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        auto next = current.set(i * 7919 % size, i + 1);
+        i++;
+        current = next;
+        benchmark::DoNotOptimize(next[0]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_VersionedPushBack_VectorCopy(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    Container::Vector<std::uint64_t> base (size, 1);
+    for (auto _ : state)
+    {
+        auto next = base;
+        next.push_back(2);
+        benchmark::DoNotOptimize(next.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_VersionedPushBack_Persistent(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    Container::PersistentVector<std::uint64_t> base {Container::Vector<std::uint64_t>(size, 1)};
+    for (auto _ : state)
+    {
+        auto next = base.push_back(2);
+        benchmark::DoNotOptimize(next.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Concat_VectorCopy(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    Container::Vector<std::uint64_t> lhs (size, 1), rhs (size, 2);
+    for (auto _ : state)
+    {
+        auto next = lhs;
+        next.insert(next.end(), rhs.begin(), rhs.end());
+        benchmark::DoNotOptimize(next.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Concat_Persistent(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    Container::PersistentVector<std::uint64_t> lhs {Container::Vector<std::uint64_t>(size, 1)};
+    Container::PersistentVector<std::uint64_t> rhs {Container::Vector<std::uint64_t>(size, 2)};
+    for (auto _ : state)
+    {
+        auto next = lhs.concat(rhs);
+        benchmark::DoNotOptimize(next.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+//a batch of appends through a transient against the same appends to a Vector
+void BM_BatchAppend_Vector(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Container::Vector<std::uint64_t> vec;
+        for (std::size_t i = 0; i < size; i++)
+            vec.push_back(i);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void BM_BatchAppend_Transient(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Container::TransientVector<std::uint64_t> builder;
+        for (std::size_t i = 0; i < size; i++)
+            builder.push_back(i);
+        auto vec = builder.persistent();
+        benchmark::DoNotOptimize(vec.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+} // namespace
+
+BENCHMARK(BM_VersionedSet_VectorCopy)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_VersionedSet_Persistent)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_VersionedPushBack_VectorCopy)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_VersionedPushBack_Persistent)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Concat_VectorCopy)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Concat_Persistent)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BatchAppend_Vector)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_BatchAppend_Transient)->Range(1 << 10, 1 << 16);
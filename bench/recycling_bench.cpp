@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include "recycling_allocator.hpp"
+#include "vector.hpp"
+
+namespace
+{
+
+using Plain    = Container::Vector<std::uint64_t>;
+using Recycled = Container::Vector<std::uint64_t, Container::RecyclingAllocator<std::uint64_t>>;
+using RecycledUsable = Container::Vector<std::uint64_t, Container::RecyclingAllocator<std::uint64_t>,
+                                         Container::Growth::UsableSize<>>;
+
+//a request handler: a few vectors built by push_back and dropped at the end of the request
+template<typename Vec>
+void BM_RequestLoop(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vec keys, values, scratch;
+        for (std::size_t i = 0; i < size; i++)
+        {
+            keys.push_back(i);
+            values.push_back(i * 3);
+        }
+        scratch.reserve(size);
+        for (std::size_t i = 0; i < size; i++)
+            scratch.push_back(keys[i] + values[i]);
+        benchmark::DoNotOptimize(scratch.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_RequestLoop, Plain)->Range(8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_RequestLoop, Recycled)->Range(8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_RequestLoop, RecycledUsable)->Range(8, 1 << 14);
+//every thread has a pool of its own, there is no shared allocator state to contend on
+BENCHMARK_TEMPLATE(BM_RequestLoop, Plain)->Arg(256)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RequestLoop, Recycled)->Arg(256)->ThreadRange(1, 16)->UseRealTime();
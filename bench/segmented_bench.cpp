@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include "vector.hpp"
+#include "segmented_vector.hpp"
+
+namespace
+{
+
+using DefaultVector   = Container::Vector<std::uint64_t>;
+using SegmentedVector = Container::SegmentedVector<std::uint64_t>;
+using StdDeque        = std::deque<std::uint64_t>;
+
+//throughput of appends plus the slowest single append, which is a full relocation for Vector
+template<typename Vec>
+void BM_AppendLatency(benchmark::State& state)
+{
+    using clock = std::chrono::steady_clock;
+    auto n = static_cast<std::size_t>(state.range(0));
+    clock::duration worst {};
+    for (auto _ : state)
+    {
+        Vec vec {};
+        for (std::size_t i = 0; i < n; i++)
+        {
+            auto start = clock::now();
+            vec.push_back(i);
+            worst = std::max(worst, clock::now() - start);
+        }
+        benchmark::DoNotOptimize(&vec.back());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["worst_push_us"] = std::chrono::duration<double, std::micro>(worst).count();
+}
+
+template<typename Vec>
+void BM_Sum(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    Vec vec {};
+    for (std::size_t i = 0; i < n; i++)
+        vec.push_back(i);
+    for (auto _ : state)
+    {
+        std::uint64_t sum = 0;
+        if constexpr (requires {vec.block(0);})
+        {
+            for (std::size_t b = 0; b < vec.block_count(); b++)
+                for (auto val : vec.block(b))
+                    sum += val;
+        }
+        else
+        {
+            for (auto val : vec)
+                sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_AppendLatency, DefaultVector)->RangeMultiplier(8)->Range(1 << 16, 1 << 25)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AppendLatency, SegmentedVector)->RangeMultiplier(8)->Range(1 << 16, 1 << 25)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_AppendLatency, StdDeque)->RangeMultiplier(8)->Range(1 << 16, 1 << 25)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Sum, DefaultVector)->RangeMultiplier(8)->Range(1 << 16, 1 << 22);
+BENCHMARK_TEMPLATE(BM_Sum, SegmentedVector)->RangeMultiplier(8)->Range(1 << 16, 1 << 22);
+BENCHMARK_TEMPLATE(BM_Sum, StdDeque)->RangeMultiplier(8)->Range(1 << 16, 1 << 22);
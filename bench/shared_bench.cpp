@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "shared_vector.hpp"
+
+namespace
+{
+
+constexpr std::size_t table_size = 4096;
+constexpr std::size_t publish_every = 1024;
+
+//handing out snapshots by deep copy under a mutex, as the readers did before
+struct CopiedTable
+{
+    std::mutex mutex;
+    Container::Vector<std::uint64_t> current = Container::Vector<std::uint64_t>(table_size, 1);
+
+    Container::Vector<std::uint64_t> load()
+    {
+        std::lock_guard lock {mutex};
+        return current;
+    }
+
+    void publish(Container::Vector<std::uint64_t> next)
+    {
+        std::lock_guard lock {mutex};
+        current.swap(next);
+    }
+
+    Container::Vector<std::uint64_t> make_next() {return Container::Vector<std::uint64_t>(table_size, 2);}
+};
+
+struct SharedTable
+{
+    Container::AtomicSharedVector<std::uint64_t> current {
+        Container::SharedVector<std::uint64_t>{Container::Vector<std::uint64_t>(table_size, 1)}};
+
+    Container::SharedVector<std::uint64_t> load() {return current.load();}
+    void publish(Container::SharedVector<std::uint64_t> next) {current.publish(std::move(next));}
+
+    Container::SharedVector<std::uint64_t> make_next()
+    {
+        return Container::SharedVector<std::uint64_t>{Container::Vector<std::uint64_t>(table_size, 2)};
+    }
+};
+
+//every thread takes a snapshot per iteration and reads from it, thread 0 also publishes a new version now and then;
+//the start and the end of the loop are barriers, so thread 0 owns setup and teardown
+template<typename Table>
+void BM_SnapshotReaders(benchmark::State& state)
+{
+    static std::unique_ptr<Table> shared;
+    if (state.thread_index() == 0)
+        shared = std::make_unique<Table>();
+
+    std::size_t i = state.thread_index();
+    for (auto _ : state)
+    {
+        auto snapshot = shared->load();
+        benchmark::DoNotOptimize(snapshot[i % table_size]);
+        if (state.thread_index() == 0 && ++i % publish_every == 0)
+            shared->publish(shared->make_next());
+    }
+
+    if (state.thread_index() == 0)
+        shared.reset();
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_SnapshotReaders, CopiedTable)->ThreadRange(1, 64)->Iterations(1 << 14)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SnapshotReaders, SharedTable)->ThreadRange(1, 64)->Iterations(1 << 14)->UseRealTime();
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+#include "vector.hpp"
+#include "soa_vector.hpp"
+
+namespace
+{
+
+//a wide record of which the filter reads one field
+struct Record
+{
+    std::uint64_t id;
+    double price;
+    std::uint32_t quantity;
+    std::uint32_t flags;
+    double history[6];
+};
+
+using RecordSoA = Container::SoAVector<std::uint64_t, double, std::uint32_t, std::uint32_t, std::array<double, 6>>;
+
+double price_of(std::size_t i) {return static_cast<double>((i * 7919) % 1000);}
+
+void BM_FilterAoS(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    Container::Vector<Record> records {};
+    records.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+        records.push_back(Record{i, price_of(i), 1, 0, {}});
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+        for (auto& record : records)
+            count += record.price > 500.0;
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_FilterSoA(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    RecordSoA records {};
+    records.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+        records.emplace_back(i, price_of(i), 1u, 0u, std::array<double, 6>{});
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+        for (auto price : records.column<1>())
+            count += price > 500.0;
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+//row-wise access through the proxy references
+void BM_RowsSoA(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    RecordSoA records {};
+    for (std::size_t i = 0; i < n; i++)
+        records.emplace_back(i, price_of(i), 1u, 0u, std::array<double, 6>{});
+    for (auto _ : state)
+    {
+        double total = 0;
+        for (auto row : records)
+            total += row.get<1>() * row.get<2>();
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_PushBackSoA(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        RecordSoA records {};
+        for (std::size_t i = 0; i < n; i++)
+            records.emplace_back(i, 1.0, 1u, 0u, std::array<double, 6>{});
+        benchmark::DoNotOptimize(records.column<0>().data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+BENCHMARK(BM_FilterAoS)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_FilterSoA)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_RowsSoA)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_PushBackSoA)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
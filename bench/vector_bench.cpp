@@ -0,0 +1,214 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "vector.hpp"
+
+namespace
+{
+
+template<typename T>
+T make_value(std::size_t i);
+
+template<>
+std::uint64_t make_value<std::uint64_t>(std::size_t i) {return i;}
+
+template<>
+std::string make_value<std::string>(std::size_t i) {return std::string(32, static_cast<char>('a' + i % 26));}
+
+template<>
+std::unique_ptr<int> make_value<std::unique_ptr<int>>(std::size_t i) {return std::make_unique<int>(static_cast<int>(i));}
+
+std::size_t weight(std::uint64_t val) {return val;}
+std::size_t weight(const std::string& val) {return val.size();}
+std::size_t weight(const std::unique_ptr<int>& val) {return *val;}
+
+template<typename Vec>
+Vec make_filled(std::size_t n)
+{
+    Vec vec {};
+    vec.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+        vec.push_back(make_value<typename Vec::value_type>(i));
+    return vec;
+}
+
+template<typename Vec>
+void BM_PushBackCopy(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    auto src = make_filled<std::vector<typename Vec::value_type>>(n);
+    for (auto _ : state)
+    {
+        Vec vec {};
+        for (const auto& val : src)
+            vec.push_back(val);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_PushBackMove(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vec vec {};
+        for (std::size_t i = 0; i < n; i++)
+            vec.push_back(make_value<typename Vec::value_type>(i));
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_Reserve(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto vec = make_filled<Vec>(n);
+        state.ResumeTiming();
+
+        vec.reserve(2 * n);
+        benchmark::DoNotOptimize(vec.data());
+
+        state.PauseTiming();
+        vec = Vec{};
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_Resize(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vec vec {};
+        vec.resize(n);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_ResizeForOverwrite(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Vec vec {};
+        vec.resize_for_overwrite(n);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_ShrinkToFit(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto vec = make_filled<Vec>(n);
+        vec.reserve(2 * n);
+        state.ResumeTiming();
+
+        vec.shrink_to_fit();
+        benchmark::DoNotOptimize(vec.data());
+
+        state.PauseTiming();
+        vec = Vec{};
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_CopyConstruct(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    auto src = make_filled<Vec>(n);
+    for (auto _ : state)
+    {
+        Vec vec (src);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_CopyAssign(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    auto src = make_filled<Vec>(n);
+    auto dst = make_filled<Vec>(n);
+    for (auto _ : state)
+    {
+        dst = src;
+        benchmark::DoNotOptimize(dst.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_Iterate(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    auto vec = make_filled<Vec>(n);
+    for (auto _ : state)
+    {
+        std::size_t sum = 0;
+        for (auto itr = vec.begin(), end = vec.end(); itr != end; ++itr)
+            sum += weight(*itr);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void BM_ReverseIterate(benchmark::State& state)
+{
+    auto n = static_cast<std::size_t>(state.range(0));
+    auto vec = make_filled<Vec>(n);
+    for (auto _ : state)
+    {
+        std::size_t sum = 0;
+        for (auto itr = vec.rbegin(), end = vec.rend(); itr != end; ++itr)
+            sum += weight(*itr);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+#define VECTOR_BENCHMARK(func, T)                                                        \
+    BENCHMARK_TEMPLATE(func, std::vector<T>)->RangeMultiplier(16)->Range(16, 1 << 20);  \
+    BENCHMARK_TEMPLATE(func, Container::Vector<T>)->RangeMultiplier(16)->Range(16, 1 << 20)
+
+#define VECTOR_BENCHMARK_ALL_TYPES(func)          \
+    VECTOR_BENCHMARK(func, std::uint64_t);        \
+    VECTOR_BENCHMARK(func, std::string);          \
+    VECTOR_BENCHMARK(func, std::unique_ptr<int>)
+
+#define VECTOR_BENCHMARK_COPYABLE_TYPES(func)     \
+    VECTOR_BENCHMARK(func, std::uint64_t);        \
+    VECTOR_BENCHMARK(func, std::string)
+
+VECTOR_BENCHMARK_COPYABLE_TYPES(BM_PushBackCopy);
+VECTOR_BENCHMARK_ALL_TYPES(BM_PushBackMove);
+VECTOR_BENCHMARK_ALL_TYPES(BM_Reserve);
+VECTOR_BENCHMARK_ALL_TYPES(BM_Resize);
+BENCHMARK_TEMPLATE(BM_ResizeForOverwrite, Container::Vector<std::uint64_t>)->RangeMultiplier(16)->Range(16, 1 << 20);
+VECTOR_BENCHMARK_ALL_TYPES(BM_ShrinkToFit);
+VECTOR_BENCHMARK_COPYABLE_TYPES(BM_CopyConstruct);
+VECTOR_BENCHMARK_COPYABLE_TYPES(BM_CopyAssign);
+VECTOR_BENCHMARK_ALL_TYPES(BM_Iterate);
+VECTOR_BENCHMARK_ALL_TYPES(BM_ReverseIterate);
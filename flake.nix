@@ -35,6 +35,7 @@
               gdb
               valgrind
               gtest
+              gbenchmark
             ];
           };
         };
@@ -0,0 +1,46 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include "vector.hpp"
+
+namespace Container
+{
+
+//hands out blocks aligned to at least Align bytes (and never less than alignof(T)),
+//e.g. cache lines or AVX2/AVX-512 registers for loops over data()
+template<typename T, std::size_t Align = 64>
+class AlignedAllocator
+{
+    static_assert(Align > 0 && (Align & (Align - 1)) == 0, "alignment must be a power of two");
+public:
+    using value_type = T;
+    static constexpr std::size_t alignment = std::max(Align, alignof(T));
+
+    template<typename U>
+    struct rebind {using other = AlignedAllocator<U, Align>;};
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        ::operator delete(ptr, n * sizeof(T), std::align_val_t{alignment});
+    }
+
+    friend bool operator==(const AlignedAllocator&, const AlignedAllocator&) noexcept {return true;}
+};
+
+template<typename T, std::size_t Align = 64, typename GrowthPolicy = Growth::Doubling>
+using AlignedVector = Vector<T, AlignedAllocator<T, Align>, GrowthPolicy>;
+
+} // namespace Container
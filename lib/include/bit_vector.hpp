@@ -0,0 +1,579 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include "index_iterator.hpp"
+#include "numeric.hpp"
+#include "vector.hpp"
+
+#ifdef VECTOR_NUMERIC_X86
+#include <immintrin.h>
+#endif
+
+namespace Container
+{
+
+//counts the set bits of n words
+using PopcountKernel = std::size_t (*)(const std::uint64_t*, std::size_t);
+
+namespace detail
+{
+
+inline constexpr std::size_t word_bits = 64;
+
+constexpr std::size_t words_for(std::size_t bits) noexcept {return (bits + word_bits - 1) / word_bits;}
+
+inline std::size_t scalar_popcount(const std::uint64_t* words, std::size_t n)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++)
+        count += std::popcount(words[i]);
+    return count;
+}
+
+#ifdef VECTOR_NUMERIC_X86
+[[gnu::target("popcnt")]] inline std::size_t popcnt_popcount(const std::uint64_t* words, std::size_t n)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++)
+        count += std::popcount(words[i]);
+    return count;
+}
+
+//nibble lookup with vpshufb, byte counts summed into 64-bit lanes by vpsadbw
+[[gnu::target("avx2,popcnt")]] inline std::size_t avx2_popcount(const std::uint64_t* words, std::size_t n)
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        auto lo = _mm256_and_si256(chunk, low);
+        auto hi = _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low);
+        auto bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    std::size_t count = _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+                        _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3);
+    for (; i < n; i++)
+        count += std::popcount(words[i]);
+    return count;
+}
+
+[[gnu::target("avx512f,avx512vpopcntdq,popcnt")]] inline std::size_t avx512_popcount(const std::uint64_t* words, std::size_t n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+    std::size_t count = _mm512_reduce_add_epi64(acc);
+    for (; i < n; i++)
+        count += std::popcount(words[i]);
+    return count;
+}
+#endif
+
+} // namespace detail
+
+//popcount kernel of one instruction set; throws std::invalid_argument if this CPU does not support it.
+//sse2 stands for the popcnt instruction, avx512 needs VPOPCNTDQ and falls back to the avx2 kernel without it
+inline PopcountKernel popcount_kernel(Numeric::Isa isa)
+{
+    using Numeric::Isa;
+    if (!Numeric::supported(isa))
+        throw std::invalid_argument{"instruction set is not supported by this CPU"};
+#ifdef VECTOR_NUMERIC_X86
+    switch (isa)
+    {
+        case Isa::scalar: return &detail::scalar_popcount;
+        case Isa::sse2:   return __builtin_cpu_supports("popcnt") ? &detail::popcnt_popcount : &detail::scalar_popcount;
+        case Isa::avx2:   return &detail::avx2_popcount;
+        case Isa::avx512: return __builtin_cpu_supports("avx512vpopcntdq") ? &detail::avx512_popcount : &detail::avx2_popcount;
+    }
+#endif
+    return &detail::scalar_popcount;
+}
+
+//popcount kernel of Numeric::best_isa()
+inline PopcountKernel popcount_kernel()
+{
+    static const PopcountKernel best = popcount_kernel(Numeric::best_isa());
+    return best;
+}
+
+namespace detail
+{
+
+//proxy for one bit of a word
+class bit_reference
+{
+    std::uint64_t* word_;
+    std::uint64_t mask_;
+
+public:
+    bit_reference(std::uint64_t* word, std::size_t bit) noexcept: word_ {word}, mask_ {std::uint64_t{1} << bit} {}
+
+    bit_reference(const bit_reference&) = default;
+
+    operator bool() const noexcept {return *word_ & mask_;}
+    bool operator~() const noexcept {return !*this;}
+
+    //assignments write the referred bit
+    const bit_reference& operator=(bool val) const noexcept
+    {
+        if (val)
+            *word_ |= mask_;
+        else
+            *word_ &= ~mask_;
+        return *this;
+    }
+    const bit_reference& operator=(const bit_reference& rhs) const noexcept {return *this = bool(rhs);}
+
+    void flip() const noexcept {*word_ ^= mask_;}
+
+    friend void swap(const bit_reference& lhs, const bit_reference& rhs) noexcept
+    {
+        bool tmp = lhs;
+        lhs = bool(rhs);
+        rhs = tmp;
+    }
+    friend void swap(const bit_reference& lhs, bool& rhs) noexcept
+    {
+        bool tmp = lhs;
+        lhs = rhs;
+        rhs = tmp;
+    }
+    friend void swap(bool& lhs, const bit_reference& rhs) noexcept {swap(rhs, lhs);}
+};
+
+} // namespace detail
+
+//packed vector of bits, 64 to a word, in a Vector<std::uint64_t>: it grows, reallocates and keeps the same
+//exception guarantees as that Vector. Bits past size() in the last word are always zero.
+//Elements are read as bool and written through detail::bit_reference proxies; whole bitmaps combine word by word
+template<typename Allocator = std::allocator<std::uint64_t>>
+class BasicBitVector final
+{
+public:
+    using word_type       = std::uint64_t;
+    using value_type      = bool;
+    using allocator_type  = Allocator;
+    using size_type       = std::size_t;
+    using reference       = detail::bit_reference;
+    using const_reference = bool;
+
+    using iterator       = detail::index_iterator<BasicBitVector, bool, reference>;
+    using const_iterator = detail::index_iterator<BasicBitVector, const bool, bool>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type npos = size_type(-1);
+
+private:
+    static constexpr size_type word_bits = detail::word_bits;
+
+    Vector<word_type, Allocator> words_;
+    size_type size_ = 0;
+
+    void clear_tail() noexcept
+    {
+        if (size_ % word_bits)
+            words_.back() &= (word_type{1} << (size_ % word_bits)) - 1;
+    }
+
+    void check_size(const BasicBitVector& rhs) const
+    {
+        if (size_ != rhs.size_)
+            throw std::invalid_argument{"bit vectors differ in size"};
+    }
+
+public:
+    BasicBitVector() = default;
+    explicit BasicBitVector(const allocator_type& alloc): words_ (alloc) {}
+
+    explicit BasicBitVector(size_type size, bool val = false, const allocator_type& alloc = allocator_type())
+    :words_ (detail::words_for(size), val ? ~word_type{0} : 0, alloc), size_ {size}
+    {
+        clear_tail();
+    }
+
+    BasicBitVector(std::initializer_list<bool> initlist, const allocator_type& alloc = allocator_type())
+    :BasicBitVector(alloc)
+    {
+        reserve(initlist.size());
+        for (auto bit : initlist)
+            push_back(bit);
+    }
+
+    //takes the words, bits past size are cleared; throws std::invalid_argument if they are too few
+    BasicBitVector(Vector<word_type, Allocator> words, size_type size)
+    :words_ (std::move(words)), size_ {size}
+    {
+        if (words_.size() < detail::words_for(size))
+            throw std::invalid_argument{"too few words for the bit count"};
+        words_.resize(detail::words_for(size));
+        clear_tail();
+    }
+
+    BasicBitVector(const BasicBitVector&) = default;
+    BasicBitVector& operator=(const BasicBitVector&) = default;
+
+    BasicBitVector(BasicBitVector&& rhs) noexcept: words_ (std::move(rhs.words_)), size_ {std::exchange(rhs.size_, 0)} {}
+    BasicBitVector& operator=(BasicBitVector&& rhs) noexcept
+    {
+        words_ = std::move(rhs.words_);
+        size_ = std::exchange(rhs.size_, 0);
+        return *this;
+    }
+
+    void swap(BasicBitVector& rhs) noexcept
+    {
+        words_.swap(rhs.words_);
+        std::swap(size_, rhs.size_);
+    }
+    friend void swap(BasicBitVector& lhs, BasicBitVector& rhs) noexcept {lhs.swap(rhs);}
+
+    allocator_type get_allocator() const {return words_.get_allocator();}
+
+public:
+    size_type size() const noexcept {return size_;}
+    size_type capacity() const noexcept {return words_.capacity() * word_bits;}
+    bool empty() const noexcept {return size_ == 0;}
+
+    //the packed words, bit i is bit i % 64 of word i / 64
+    std::span<const word_type> words() const noexcept {return {words_.data(), words_.size()};}
+    const word_type* data() const noexcept {return words_.data();}
+
+    reference operator[](size_type index) noexcept {return reference{&words_[index / word_bits], index % word_bits};}
+    const_reference operator[](size_type index) const noexcept {return test(index);}
+
+    reference at(size_type index)
+    {
+        if (index >= size_)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return (*this)[index];
+    }
+    const_reference at(size_type index) const
+    {
+        if (index >= size_)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return (*this)[index];
+    }
+
+    reference front()
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return (*this)[0];
+    }
+    const_reference front() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return (*this)[0];
+    }
+
+    reference back()
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return (*this)[size_ - 1];
+    }
+    const_reference back() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return (*this)[size_ - 1];
+    }
+
+    bool test(size_type index) const noexcept {return words_[index / word_bits] >> (index % word_bits) & 1;}
+    void set(size_type index, bool val = true) noexcept {(*this)[index] = val;}
+    void reset(size_type index) noexcept {(*this)[index] = false;}
+    void flip(size_type index) noexcept {(*this)[index].flip();}
+
+public:
+    void push_back(bool val)
+    {
+        if (size_ % word_bits == 0)
+            words_.push_back(word_type{val});
+        else if (val)
+            words_.back() |= word_type{1} << (size_ % word_bits);
+        size_++;
+    }
+
+    void pop_back()
+    {
+        if (empty())
+            throw std::underflow_error{"try to pop element from empty vector"};
+        size_--;
+        if (size_ % word_bits == 0)
+            words_.pop_back();
+        else
+            clear_tail();
+    }
+
+    //new bits are val
+    void resize(size_type newsz, bool val = false)
+    {
+        auto old = size_;
+        words_.resize(detail::words_for(newsz), val ? ~word_type{0} : 0);
+        if (val && newsz > old && old % word_bits)
+            words_[old / word_bits] |= ~word_type{0} << (old % word_bits);
+        size_ = newsz;
+        clear_tail();
+    }
+
+    void reserve(size_type newsz) {words_.reserve(detail::words_for(newsz));}
+    void shrink_to_fit() {words_.shrink_to_fit();}
+
+    void clear() noexcept
+    {
+        words_.clear();
+        size_ = 0;
+    }
+
+public:
+    //whole vector operations
+
+    //number of set bits
+    size_type count() const noexcept {return popcount_kernel()(words_.data(), words_.size());}
+
+    bool any() const noexcept {return std::any_of(words_.begin(), words_.end(), [](word_type word){return word != 0;});}
+    bool none() const noexcept {return !any();}
+    bool all() const noexcept {return count() == size_;}
+
+    BasicBitVector& set() noexcept
+    {
+        std::fill(words_.begin(), words_.end(), ~word_type{0});
+        clear_tail();
+        return *this;
+    }
+
+    BasicBitVector& reset() noexcept
+    {
+        std::fill(words_.begin(), words_.end(), word_type{0});
+        return *this;
+    }
+
+    BasicBitVector& flip() noexcept
+    {
+        for (auto& word : words_)
+            word = ~word;
+        clear_tail();
+        return *this;
+    }
+
+    //operands must have equal sizes, otherwise std::invalid_argument is thrown
+    BasicBitVector& operator&=(const BasicBitVector& rhs)
+    {
+        check_size(rhs);
+        for (size_type i = 0; i < words_.size(); i++)
+            words_[i] &= rhs.words_[i];
+        return *this;
+    }
+
+    BasicBitVector& operator|=(const BasicBitVector& rhs)
+    {
+        check_size(rhs);
+        for (size_type i = 0; i < words_.size(); i++)
+            words_[i] |= rhs.words_[i];
+        return *this;
+    }
+
+    BasicBitVector& operator^=(const BasicBitVector& rhs)
+    {
+        check_size(rhs);
+        for (size_type i = 0; i < words_.size(); i++)
+            words_[i] ^= rhs.words_[i];
+        return *this;
+    }
+
+    //clears the bits set in rhs
+    BasicBitVector& and_not(const BasicBitVector& rhs)
+    {
+        check_size(rhs);
+        for (size_type i = 0; i < words_.size(); i++)
+            words_[i] &= ~rhs.words_[i];
+        return *this;
+    }
+
+    BasicBitVector operator~() const
+    {
+        auto result = *this;
+        return std::move(result.flip());
+    }
+
+    friend BasicBitVector operator&(BasicBitVector lhs, const BasicBitVector& rhs) {return std::move(lhs &= rhs);}
+    friend BasicBitVector operator|(BasicBitVector lhs, const BasicBitVector& rhs) {return std::move(lhs |= rhs);}
+    friend BasicBitVector operator^(BasicBitVector lhs, const BasicBitVector& rhs) {return std::move(lhs ^= rhs);}
+
+    friend bool operator==(const BasicBitVector& lhs, const BasicBitVector& rhs) noexcept
+    {
+        return lhs.size_ == rhs.size_ && Ranges::equal(lhs.words_.begin(), lhs.words_.end(), rhs.words_.begin(), rhs.words_.end());
+    }
+
+    //index of the first set bit at pos or after it, npos if there is none
+    size_type find_next(size_type pos) const noexcept
+    {
+        if (pos >= size_)
+            return npos;
+        auto w = pos / word_bits;
+        auto word = words_[w] & (~word_type{0} << (pos % word_bits));
+        while (!word)
+        {
+            if (++w == words_.size())
+                return npos;
+            word = words_[w];
+        }
+        return w * word_bits + std::countr_zero(word);
+    }
+
+    size_type find_first() const noexcept {return find_next(0);}
+
+public:
+    iterator begin() noexcept {return iterator{this, 0};}
+    iterator end()   noexcept {return iterator{this, size_};}
+
+    const_iterator begin() const noexcept {return const_iterator{this, 0};}
+    const_iterator end()   const noexcept {return const_iterator{this, size_};}
+
+    const_iterator cbegin() const noexcept {return begin();}
+    const_iterator cend()   const noexcept {return end();}
+
+    reverse_iterator rbegin() noexcept {return reverse_iterator{end()};}
+    reverse_iterator rend()   noexcept {return reverse_iterator{begin()};}
+
+    const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator{end()};}
+    const_reverse_iterator rend()   const noexcept {return const_reverse_iterator{begin()};}
+}; // class BasicBitVector
+
+using BitVector = BasicBitVector<>;
+
+//rank and select index over the words of a bit vector, which must outlive it and stay unchanged.
+//Per 512-bit block it keeps the ones before the block and the 9-bit counts of each word's prefix within it,
+//16 bytes per 64 bytes of bits: rank is two lookups and a popcount, select a binary search over the blocks
+class RankSelect
+{
+    static constexpr std::size_t block_words = 8;
+    static constexpr std::size_t block_bits  = block_words * detail::word_bits;
+
+    std::span<const std::uint64_t> words_;
+    std::size_t size_ = 0, ones_ = 0;
+    //ones before the block and the packed relative counts, per block
+    Vector<std::uint64_t> blocks_;
+
+    std::size_t relative(std::size_t block, std::size_t word) const noexcept
+    {
+        return word ? blocks_[2 * block + 1] >> (9 * (word - 1)) & 0x1ff : 0;
+    }
+
+    //position of the k-th (from 0) set bit of word
+    static std::size_t select_in_word(std::uint64_t word, std::size_t k) noexcept
+    {
+        for (; k; k--)
+            word &= word - 1;
+        return std::countr_zero(word);
+    }
+
+    //Ones selects ones or zeros
+    template<bool Ones>
+    std::size_t select(std::size_t k) const
+    {
+        auto total = Ones ? ones_ : size_ - ones_;
+        if (k >= total)
+            throw std::out_of_range{"try to select past the last bit"};
+
+        auto before = [this](std::size_t block)
+        {
+            auto ones = blocks_[2 * block];
+            return Ones ? ones : block * block_bits - ones;
+        };
+        //last block with fewer than k + 1 bits before it
+        std::size_t lo = 0, hi = blocks_.size() / 2;
+        while (hi - lo > 1)
+        {
+            auto mid = lo + (hi - lo) / 2;
+            if (before(mid) <= k)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        k -= before(lo);
+
+        std::size_t word = 1;
+        for (; word < block_words && lo * block_words + word < words_.size(); word++)
+        {
+            auto rel = relative(lo, word);
+            if ((Ones ? rel : word * detail::word_bits - rel) > k)
+                break;
+        }
+        word--;
+        auto rel = relative(lo, word);
+        k -= Ones ? rel : word * detail::word_bits - rel;
+
+        auto index = lo * block_words + word;
+        auto bits = Ones ? words_[index] : ~words_[index];
+        return index * detail::word_bits + select_in_word(bits, k);
+    }
+
+public:
+    RankSelect() = default;
+
+    template<typename Allocator>
+    explicit RankSelect(const BasicBitVector<Allocator>& bits): RankSelect(bits.words(), bits.size()) {}
+
+    //bits past size must be zero
+    RankSelect(std::span<const std::uint64_t> words, std::size_t size)
+    :words_ {words}, size_ {size}
+    {
+        auto blocks = (words.size() + block_words - 1) / block_words;
+        blocks_.reserve(2 * blocks);
+        for (std::size_t block = 0; block < blocks; block++)
+        {
+            std::uint64_t packed = 0, in_block = 0;
+            for (std::size_t word = 0; word < block_words; word++)
+            {
+                auto index = block * block_words + word;
+                if (word)
+                    packed |= in_block << (9 * (word - 1));
+                if (index < words.size())
+                    in_block += std::popcount(words[index]);
+            }
+            blocks_.push_back(ones_);
+            blocks_.push_back(packed);
+            ones_ += in_block;
+        }
+    }
+
+    std::size_t size() const noexcept {return size_;}
+    std::size_t ones() const noexcept {return ones_;}
+
+    //set bits in [0, index), index <= size
+    std::size_t rank1(std::size_t index) const
+    {
+        if (index > size_)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        if (index == size_)
+            return ones_;
+        auto word = index / detail::word_bits, block = word / block_words;
+        auto mask = (std::uint64_t{1} << (index % detail::word_bits)) - 1;
+        return blocks_[2 * block] + relative(block, word % block_words) + std::popcount(words_[word] & mask);
+    }
+
+    std::size_t rank0(std::size_t index) const {return index - rank1(index);}
+
+    //index of the k-th set (clear) bit counting from 0; throws std::out_of_range if there are not that many
+    std::size_t select1(std::size_t k) const {return select<true>(k);}
+    std::size_t select0(std::size_t k) const {return select<false>(k);}
+}; // class RankSelect
+
+} // namespace Container
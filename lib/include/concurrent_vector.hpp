@@ -0,0 +1,289 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include "index_iterator.hpp"
+
+namespace Container
+{
+
+//Vector that many threads may push_back to at once without a lock.
+//A push claims an index with one fetch_add; the storage is a table of segments of FirstSegment, 2 * FirstSegment,
+//4 * FirstSegment... elements allocated and installed by the first thread that needs them, so elements
+//never move and references stay valid until the vector is destroyed.
+//size() counts claimed slots, an element is published when its construction finishes: get() returns nullptr
+//until then, operator[] and the iterators are for elements the caller knows to be constructed
+//(its own pushes, or everything after the writers are joined).
+//A push that throws, from the constructor or from allocating a segment, leaves a hole that get() keeps
+//reporting as nullptr.
+template<typename T, typename Allocator = std::allocator<T>, std::size_t FirstSegment = 32>
+class ConcurrentVector final
+{
+    static_assert(std::has_single_bit(FirstSegment), "FirstSegment must be a power of two");
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+
+    using iterator       = detail::index_iterator<ConcurrentVector, T>;
+    using const_iterator = detail::index_iterator<ConcurrentVector, const T>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    struct segment
+    {
+        pointer data;
+        std::atomic<bool>* constructed;
+    };
+    using segment_allocator = typename alloc_traits::template rebind_alloc<segment>;
+    using flag_allocator    = typename alloc_traits::template rebind_alloc<std::atomic<bool>>;
+
+    static constexpr size_type first_shift  = std::bit_width(FirstSegment) - 1;
+    static constexpr size_type max_segments = sizeof(size_type) * 8 - first_shift;
+
+    [[no_unique_address]] allocator_type alloc_;
+    std::atomic<size_type> size_ {0};
+    std::atomic<segment*> segments_[max_segments] {};
+
+    static constexpr size_type segment_size(size_type k) noexcept {return FirstSegment << k;}
+
+    //segment k holds indices [FirstSegment * (2^k - 1), FirstSegment * (2^(k + 1) - 1))
+    static constexpr size_type segment_of(size_type index) noexcept
+    {
+        return std::bit_width((index >> first_shift) + 1) - 1;
+    }
+    static constexpr size_type segment_start(size_type k) noexcept {return FirstSegment * ((size_type{1} << k) - 1);}
+
+    segment* create_segment(size_type k)
+    {
+        segment_allocator seg_alloc {alloc_};
+        flag_allocator flag_alloc {alloc_};
+        auto size = segment_size(k);
+
+        auto seg = std::allocator_traits<segment_allocator>::allocate(seg_alloc, 1);
+        try
+        {
+            seg->data = alloc_traits::allocate(alloc_, size);
+            try
+            {
+                seg->constructed = std::allocator_traits<flag_allocator>::allocate(flag_alloc, size);
+            }
+            catch (...)
+            {
+                alloc_traits::deallocate(alloc_, seg->data, size);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            std::allocator_traits<segment_allocator>::deallocate(seg_alloc, seg, 1);
+            throw;
+        }
+        std::uninitialized_value_construct_n(seg->constructed, size);
+        return seg;
+    }
+
+    void destroy_segment(segment* seg, size_type k) noexcept
+    {
+        segment_allocator seg_alloc {alloc_};
+        flag_allocator flag_alloc {alloc_};
+        auto size = segment_size(k);
+        for (size_type i = 0; i < size; i++)
+            if (seg->constructed[i].load(std::memory_order_relaxed))
+                alloc_traits::destroy(alloc_, seg->data + i);
+        std::destroy_n(seg->constructed, size);
+        std::allocator_traits<flag_allocator>::deallocate(flag_alloc, seg->constructed, size);
+        alloc_traits::deallocate(alloc_, seg->data, size);
+        std::allocator_traits<segment_allocator>::deallocate(seg_alloc, seg, 1);
+    }
+
+    //marks a slot whose segment one thread is allocating; never dereferenced
+    static inline segment building_ {};
+
+    //installs segment k unless another thread already did: the first thread to claim the slot allocates it,
+    //the others wait instead of allocating a copy to throw away. If the allocation fails the slot is freed
+    //and a waiter tries again
+    segment* acquire_segment(size_type k)
+    {
+        auto seg = segments_[k].load(std::memory_order_acquire);
+        for (;;)
+        {
+            if (seg == &building_)
+            {
+                segments_[k].wait(seg, std::memory_order_acquire);
+                seg = segments_[k].load(std::memory_order_acquire);
+            }
+            else if (seg)
+                return seg;
+            else if (segments_[k].compare_exchange_weak(seg, &building_, std::memory_order_acquire))
+                break;
+        }
+
+        try
+        {
+            seg = create_segment(k);
+        }
+        catch (...)
+        {
+            segments_[k].store(nullptr, std::memory_order_release);
+            segments_[k].notify_all();
+            throw;
+        }
+        segments_[k].store(seg, std::memory_order_release);
+        segments_[k].notify_all();
+        return seg;
+    }
+
+    //nullptr while the segment is being allocated
+    segment* segment_at(size_type k) const noexcept
+    {
+        auto seg = segments_[k].load(std::memory_order_acquire);
+        return (seg == &building_) ? nullptr : seg;
+    }
+
+public:
+    ConcurrentVector() = default;
+
+    explicit ConcurrentVector(const allocator_type& alloc) noexcept: alloc_ {alloc} {}
+
+    ConcurrentVector(const ConcurrentVector&)            = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector()
+    {
+        for (size_type k = 0; k < max_segments; k++)
+            if (auto seg = segments_[k].load(std::memory_order_relaxed))
+                destroy_segment(seg, k);
+    }
+
+    allocator_type get_allocator() const {return alloc_;}
+
+    //thread safe
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        auto index = size_.fetch_add(1, std::memory_order_relaxed);
+        auto k = segment_of(index);
+        if (k >= max_segments)
+            throw std::length_error{"ConcurrentVector is full"};
+        auto seg = acquire_segment(k);
+        auto offset = index - segment_start(k);
+        alloc_traits::construct(alloc_, seg->data + offset, std::forward<Args>(args)...);
+        seg->constructed[offset].store(true, std::memory_order_release);
+        return seg->data[offset];
+    }
+
+    //thread safe
+    reference push_back(const value_type& val) {return emplace_back(val);}
+    reference push_back(value_type&& val) {return emplace_back(std::move(val));}
+
+    //thread safe; installs the segments for the first n elements up front
+    void reserve(size_type n)
+    {
+        if (n == 0)
+            return;
+        for (size_type k = 0, last = segment_of(n - 1); k <= last; k++)
+            acquire_segment(k);
+    }
+
+    //thread safe; number of claimed slots, some of which may still be under construction
+    size_type size() const {return size_.load(std::memory_order_acquire);}
+    bool empty() const {return size() == 0;}
+
+    //thread safe; capacity of the installed segments
+    size_type capacity() const
+    {
+        size_type k = 0;
+        while (k < max_segments && segment_at(k))
+            k++;
+        return segment_start(k);
+    }
+
+    //thread safe; nullptr if element index is not constructed yet
+    pointer get(size_type index) noexcept
+    {
+        return const_cast<pointer>(static_cast<const ConcurrentVector&>(*this).get(index));
+    }
+    const_pointer get(size_type index) const noexcept
+    {
+        auto k = segment_of(index);
+        if (k >= max_segments)
+            return nullptr;
+        auto seg = segment_at(k);
+        auto offset = index - segment_start(k);
+        if (!seg || !seg->constructed[offset].load(std::memory_order_acquire))
+            return nullptr;
+        return seg->data + offset;
+    }
+
+    reference operator[](size_type index) noexcept
+    {
+        auto k = segment_of(index);
+        return segment_at(k)->data[index - segment_start(k)];
+    }
+    const_reference operator[](size_type index) const noexcept
+    {
+        auto k = segment_of(index);
+        return segment_at(k)->data[index - segment_start(k)];
+    }
+
+    reference at(size_type index)
+    {
+        auto ptr = get(index);
+        if (index >= size() || !ptr)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return *ptr;
+    }
+    const_reference at(size_type index) const
+    {
+        auto ptr = get(index);
+        if (index >= size() || !ptr)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return *ptr;
+    }
+
+    //not thread safe; keeps the segments
+    void clear()
+    {
+        auto used = size_.load(std::memory_order_relaxed);
+        for (size_type k = 0; k < max_segments && segment_start(k) < used; k++)
+        {
+            auto seg = segment_at(k);
+            if (!seg)
+                continue;
+            for (size_type i = 0; i < segment_size(k); i++)
+                if (seg->constructed[i].exchange(false, std::memory_order_relaxed))
+                    alloc_traits::destroy(alloc_, seg->data + i);
+        }
+        size_.store(0, std::memory_order_release);
+    }
+
+    iterator begin() {return iterator{this, 0};}
+    iterator end()   {return iterator{this, size()};}
+
+    const_iterator begin() const {return const_iterator{this, 0};}
+    const_iterator end()   const {return const_iterator{this, size()};}
+
+    const_iterator cbegin() const {return const_iterator{this, 0};}
+    const_iterator cend()   const {return const_iterator{this, size()};}
+
+    reverse_iterator rbegin() {return reverse_iterator{end()};}
+    reverse_iterator rend()   {return reverse_iterator{begin()};}
+
+    const_reverse_iterator rbegin() const {return const_reverse_iterator{end()};}
+    const_reverse_iterator rend()   const {return const_reverse_iterator{begin()};}
+
+    const_reverse_iterator crbegin() const {return const_reverse_iterator{cend()};}
+    const_reverse_iterator crend()   const {return const_reverse_iterator{cbegin()};}
+}; // class ConcurrentVector
+
+} // namespace Container
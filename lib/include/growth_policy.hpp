@@ -0,0 +1,52 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+namespace Container
+{
+
+//A growth policy decides the capacity Vector asks for when an insertion overflows it:
+//    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t elem_size);
+//and may set claim_slack to keep whatever extra the allocator reports through allocate_at_least.
+namespace Growth
+{
+
+//capacity * Num / Den + 1
+template<std::size_t Num, std::size_t Den>
+struct Geometric
+{
+    static_assert(Num > Den && Den > 0, "Geometric growth needs a factor greater than 1");
+
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept
+    {
+        return std::max(capacity + capacity / Den * (Num - Den) + capacity % Den * (Num - Den) / Den + 1, required);
+    }
+};
+
+using Doubling   = Geometric<2, 1>;
+using OneAndHalf = Geometric<3, 2>;
+
+//rounds blocks of at least a page up to whole pages, so the tail of the last page is not wasted
+template<typename Base = Doubling, std::size_t PageSize = 4096>
+struct PageRounded
+{
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t elem_size) noexcept
+    {
+        auto n = Base::next_capacity(capacity, required, elem_size);
+        auto bytes = n * elem_size;
+        if (bytes < PageSize)
+            return n;
+        return (bytes + PageSize - 1) / PageSize * PageSize / elem_size;
+    }
+};
+
+//claims the slack the allocator already handed out, e.g. malloc_usable_size with MallocAllocator
+template<typename Base = Doubling>
+struct UsableSize: Base
+{
+    static constexpr bool claim_slack = true;
+};
+
+} // namespace Growth
+
+} // namespace Container
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include "os_memory.hpp"
+
+namespace Container
+{
+
+//Allocator for giant vectors: blocks of MmapThreshold bytes or more are mapped on huge pages
+//(MAP_HUGETLB, or transparent huge pages when none are reserved) to cut TLB misses on random access,
+//smaller ones come from ::operator new.
+//Vector calls release_unused() when it shrinks, so the pages past the last element go back to the OS.
+template<typename T, std::size_t MmapThreshold = std::size_t{1} << 21>
+class HugePageAllocator
+{
+public:
+    using value_type = T;
+    static constexpr std::size_t mmap_threshold = MmapThreshold;
+
+    template<typename U>
+    struct rebind {using other = HugePageAllocator<U, MmapThreshold>;};
+
+    HugePageAllocator() = default;
+
+    template<typename U>
+    HugePageAllocator(const HugePageAllocator<U, MmapThreshold>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+        auto bytes = n * sizeof(T);
+        if (!is_mapped(bytes))
+            return std::allocator<T>{}.allocate(n);
+
+        auto ptr = os::map_huge(bytes);
+        if (!ptr)
+            throw std::bad_alloc{};
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        auto bytes = n * sizeof(T);
+        if (is_mapped(bytes))
+            os::unmap_huge(ptr, bytes);
+        else
+            std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    //the elements past used are destroyed; their whole huge pages are dropped, a later write faults in zeros.
+    //Huge pages are the unit of both kinds of mapping, so transparent ones are not split either.
+    //false if the kernel kept the pages, the block stays valid then
+    bool release_unused(T* ptr, std::size_t n, std::size_t used) noexcept
+    {
+        if (!is_mapped(n * sizeof(T)))
+            return true;
+        return os::discard(ptr + used, (n - used) * sizeof(T), os::huge_page_size());
+    }
+
+    friend bool operator==(const HugePageAllocator&, const HugePageAllocator&) noexcept {return true;}
+
+private:
+    static bool is_mapped(std::size_t bytes) noexcept {return bytes >= MmapThreshold;}
+};
+
+} // namespace Container
@@ -0,0 +1,99 @@
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace Container
+{
+
+namespace detail
+{
+
+//random access iterator over a container that is not contiguous but has O(1) operator[];
+//Value is const for const iterators. Reference is whatever operator[] returns, it may be a proxy object,
+//then the iterator has no operator->
+template<typename Cont, typename Value, typename Reference = Value&>
+class index_iterator
+{
+    using container = std::conditional_t<std::is_const<Value>::value, const Cont, Cont>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = std::remove_cv_t<Value>;
+    using reference         = Reference;
+    using pointer           = std::conditional_t<std::is_reference<Reference>::value, Value*, void>;
+
+private:
+    container* cont_ = nullptr;
+    std::size_t index_ = 0;
+
+public:
+    index_iterator() = default;
+    index_iterator(container* cont, std::size_t index): cont_ {cont}, index_ {index} {}
+
+    //iterator to const_iterator
+    template<typename V, typename R>
+    requires std::is_convertible<V*, Value*>::value
+    index_iterator(const index_iterator<Cont, V, R>& itr): cont_ {itr.cont_}, index_ {itr.index_} {}
+
+    reference operator*() const {return (*cont_)[index_];}
+    pointer operator->() const requires std::is_reference<Reference>::value {return &(*cont_)[index_];}
+    reference operator[](difference_type diff) const {return (*cont_)[index_ + diff];}
+
+    std::size_t index() const {return index_;}
+
+    index_iterator& operator++()
+    {
+        index_++;
+        return *this;
+    }
+    index_iterator operator++(int)
+    {
+        index_iterator tmp (*this);
+        ++(*this);
+        return tmp;
+    }
+    index_iterator& operator--()
+    {
+        index_--;
+        return *this;
+    }
+    index_iterator operator--(int)
+    {
+        index_iterator tmp (*this);
+        --(*this);
+        return tmp;
+    }
+
+    index_iterator& operator+=(difference_type diff)
+    {
+        index_ += diff;
+        return *this;
+    }
+    index_iterator& operator-=(difference_type diff)
+    {
+        index_ -= diff;
+        return *this;
+    }
+
+    friend index_iterator operator+(index_iterator itr, difference_type diff) {return itr += diff;}
+    friend index_iterator operator+(difference_type diff, index_iterator itr) {return itr += diff;}
+    friend index_iterator operator-(index_iterator itr, difference_type diff) {return itr -= diff;}
+
+    difference_type operator-(const index_iterator& itr) const
+    {
+        return static_cast<difference_type>(index_) - static_cast<difference_type>(itr.index_);
+    }
+
+    bool operator==(const index_iterator& other) const {return index_ == other.index_;}
+    std::strong_ordering operator<=>(const index_iterator& other) const {return index_ <=> other.index_;}
+
+    template<typename C, typename V, typename R>
+    friend class index_iterator;
+};
+
+} // namespace detail
+
+} // namespace Container
@@ -0,0 +1,106 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include "vector.hpp"
+
+namespace Container
+{
+
+namespace detail
+{
+
+//keeps exactly N elements in the object itself and never allocates: asking for more capacity throws
+//std::length_error, so an overflowing InplaceVector fails the same way at run time and in constant evaluation.
+//The elements live in a union, so they can be constructed one by one in constant evaluation
+template<typename T, std::size_t N, typename Allocator>
+class InplaceVectorBuf: public VectorBuf<T, Allocator>
+{
+    using base           = VectorBuf<T, Allocator>;
+    using pointer        = T*;
+    using size_type      = std::size_t;
+    using allocator_type = Allocator;
+
+    static_assert(N > 0, "InplaceVector needs a capacity");
+protected:
+    using base::alloc_;
+    using base::size_;
+    using base::used_;
+    using base::data_;
+    using typename base::allocation;
+
+    static constexpr size_type inline_capacity = N;
+    static constexpr bool can_reallocate = false;
+    static constexpr bool nothrow_swap = std::is_nothrow_move_constructible<T>::value && std::is_nothrow_swappable<T>::value;
+
+private:
+    union storage
+    {
+        constexpr storage() {}
+        constexpr ~storage() {}
+        T elems[N];
+    } storage_;
+
+protected:
+    constexpr InplaceVectorBuf(size_type size = 0, const allocator_type& alloc = allocator_type()): base(0, alloc)
+    {
+        if (size > N)
+            throw std::length_error{"InplaceVector capacity exceeded"};
+        data_ = storage_.elems;
+        size_ = N;
+    }
+
+    //leaves rhs empty
+    constexpr InplaceVectorBuf(InplaceVectorBuf&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+    :base(0, rhs.alloc_)
+    {
+        data_ = storage_.elems;
+        size_ = N;
+        Ranges::uninitialized_relocate(alloc_, rhs.data_, rhs.data_ + rhs.used_, data_);
+        used_ = std::exchange(rhs.used_, 0);
+    }
+
+    //the only block is the inline one
+    constexpr allocation allocate_at_least(size_type n, bool = false)
+    {
+        if (n > N)
+            throw std::length_error{"InplaceVector capacity exceeded"};
+        return {storage_.elems, N};
+    }
+
+    constexpr void deallocate(pointer, size_type) noexcept {}
+
+    constexpr void release_unused() noexcept {}
+
+    constexpr void swap_data(InplaceVectorBuf& rhs) noexcept(nothrow_swap)
+    {
+        auto& shorter = (used_ <= rhs.used_) ? *this : rhs;
+        auto& longer  = (used_ <= rhs.used_) ? rhs : *this;
+        std::swap_ranges(shorter.data_, shorter.data_ + shorter.used_, longer.data_);
+        Ranges::uninitialized_relocate(alloc_, longer.data_ + shorter.used_, longer.data_ + longer.used_,
+                                       shorter.data_ + shorter.used_);
+        std::swap(used_, rhs.used_);
+    }
+
+    constexpr void swap(InplaceVectorBuf& rhs) noexcept(nothrow_swap)
+    {
+        using std::swap;
+        swap_data(rhs);
+        swap(alloc_, rhs.alloc_);
+    }
+
+    constexpr ~InplaceVectorBuf()
+    {
+        Ranges::destroy(alloc_, data_, data_ + used_);
+        data_ = nullptr;
+        size_ = used_ = 0;
+    }
+};
+
+} // namespace detail
+
+//Vector with a fixed capacity of N elements stored inline; it is usable in constant evaluation
+template<typename T, std::size_t N, typename Allocator = std::allocator<T>>
+using InplaceVector = Vector<T, Allocator, Growth::Doubling, detail::InplaceVectorBuf<T, N, Allocator>>;
+
+} // namespace Container
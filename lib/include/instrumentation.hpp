@@ -0,0 +1,226 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include "my_ranges.hpp"
+#include "instrumentation_hooks.hpp"
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+//counters of allocations and relocations done by Container::Vector, kept per element type.
+//The hooks Vector calls are in instrumentation_hooks.hpp and count only when VECTOR_INSTRUMENTATION is defined,
+//they are empty otherwise and Vector does not include this header; all translation units of a program must agree
+//on the macro
+namespace Container::Instrumentation
+{
+
+struct Counters
+{
+    std::atomic<std::uint64_t> allocations {};
+    std::atomic<std::uint64_t> reserve_reallocations {};
+    std::atomic<std::uint64_t> resize_reallocations {};
+    std::atomic<std::uint64_t> shrink_reallocations {};
+    std::atomic<std::uint64_t> growth_reallocations {};
+    std::atomic<std::uint64_t> bytes_relocated {};
+    std::atomic<std::uint64_t> elements_relocated_bitwise {};
+    std::atomic<std::uint64_t> elements_moved {};
+    std::atomic<std::uint64_t> elements_copied {};
+    std::atomic<std::uint64_t> peak_capacity {};
+};
+
+//plain copy of Counters
+struct Snapshot
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t reserve_reallocations = 0;
+    std::uint64_t resize_reallocations = 0;
+    std::uint64_t shrink_reallocations = 0;
+    std::uint64_t growth_reallocations = 0;
+    std::uint64_t bytes_relocated = 0;
+    std::uint64_t elements_relocated_bitwise = 0;
+    std::uint64_t elements_moved = 0;
+    std::uint64_t elements_copied = 0;
+    std::uint64_t peak_capacity = 0;
+
+    Snapshot() = default;
+
+    explicit Snapshot(const Counters& counters)
+    :allocations {counters.allocations.load(std::memory_order_relaxed)},
+     reserve_reallocations {counters.reserve_reallocations.load(std::memory_order_relaxed)},
+     resize_reallocations {counters.resize_reallocations.load(std::memory_order_relaxed)},
+     shrink_reallocations {counters.shrink_reallocations.load(std::memory_order_relaxed)},
+     growth_reallocations {counters.growth_reallocations.load(std::memory_order_relaxed)},
+     bytes_relocated {counters.bytes_relocated.load(std::memory_order_relaxed)},
+     elements_relocated_bitwise {counters.elements_relocated_bitwise.load(std::memory_order_relaxed)},
+     elements_moved {counters.elements_moved.load(std::memory_order_relaxed)},
+     elements_copied {counters.elements_copied.load(std::memory_order_relaxed)},
+     peak_capacity {counters.peak_capacity.load(std::memory_order_relaxed)}
+    {}
+};
+
+//counters are created on first use and live until the end of the program,
+//so references handed out by counters() never dangle
+class Registry
+{
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Counters>, std::less<>> counters_;
+
+    Registry() = default;
+
+public:
+    Registry(const Registry&)            = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    static Registry& instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    Counters& counters(const std::string& tag)
+    {
+        std::lock_guard lock {mutex_};
+        auto& slot = counters_[tag];
+        if (!slot)
+            slot = std::make_unique<Counters>();
+        return *slot;
+    }
+
+    //zero snapshot for tags that were never used
+    Snapshot snapshot(const std::string& tag) const
+    {
+        std::lock_guard lock {mutex_};
+        auto found = counters_.find(tag);
+        return (found == counters_.end()) ? Snapshot{} : Snapshot{*found->second};
+    }
+
+    void reset()
+    {
+        std::lock_guard lock {mutex_};
+        for (auto& [tag, counters] : counters_)
+        {
+            for (auto* counter : {&counters->allocations, &counters->reserve_reallocations,
+                                  &counters->resize_reallocations, &counters->shrink_reallocations,
+                                  &counters->growth_reallocations, &counters->bytes_relocated,
+                                  &counters->elements_relocated_bitwise, &counters->elements_moved,
+                                  &counters->elements_copied, &counters->peak_capacity})
+                counter->store(0, std::memory_order_relaxed);
+        }
+    }
+
+    //one line per tag
+    void dump(std::ostream& os) const
+    {
+        std::lock_guard lock {mutex_};
+        for (auto& [tag, counters] : counters_)
+        {
+            Snapshot snap {*counters};
+            os << tag << ":"
+               << " allocations=" << snap.allocations
+               << " reallocations(reserve/resize/shrink/growth)=" << snap.reserve_reallocations << "/"
+               << snap.resize_reallocations << "/" << snap.shrink_reallocations << "/" << snap.growth_reallocations
+               << " bytes_relocated=" << snap.bytes_relocated
+               << " bitwise=" << snap.elements_relocated_bitwise
+               << " moved=" << snap.elements_moved
+               << " copied=" << snap.elements_copied
+               << " peak_capacity=" << snap.peak_capacity << "\n";
+        }
+    }
+};
+
+inline std::string demangle(const char* name)
+{
+#if defined(__GNUG__)
+    int status = 0;
+    std::unique_ptr<char, void(*)(void*)> demangled {abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free};
+    if (status == 0 && demangled)
+        return demangled.get();
+#endif
+    return name;
+}
+
+//name the counters of vectors of T are kept under; specialize to rename or to merge types
+template<typename T>
+struct type_tag
+{
+    static std::string name() {return demangle(typeid(T).name());}
+};
+
+template<typename T>
+Counters& counters_for()
+{
+    static Counters& counters = Registry::instance().counters(type_tag<T>::name());
+    return counters;
+}
+
+inline void update_max(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+{
+    auto current = counter.load(std::memory_order_relaxed);
+    while (current < value && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        ;
+}
+
+#ifdef VECTOR_INSTRUMENTATION
+
+template<typename T>
+constexpr void record_allocation(std::size_t count)
+{
+    if (std::is_constant_evaluated())
+        return;
+    auto& counters = counters_for<T>();
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    update_max(counters.peak_capacity, count);
+}
+
+template<typename T>
+constexpr void record_reallocation(Reallocation cause)
+{
+    if (std::is_constant_evaluated())
+        return;
+    auto& counters = counters_for<T>();
+    switch (cause)
+    {
+        case Reallocation::reserve:       counters.reserve_reallocations.fetch_add(1, std::memory_order_relaxed); break;
+        case Reallocation::resize:        counters.resize_reallocations.fetch_add(1, std::memory_order_relaxed); break;
+        case Reallocation::shrink_to_fit: counters.shrink_reallocations.fetch_add(1, std::memory_order_relaxed); break;
+        case Reallocation::growth:        counters.growth_reallocations.fetch_add(1, std::memory_order_relaxed); break;
+    }
+}
+
+//n elements went through Ranges::uninitialized_relocate or its strong-guarantee fallback
+template<typename T, typename Alloc>
+constexpr void record_relocation(std::size_t n)
+{
+    if (std::is_constant_evaluated())
+        return;
+    auto& counters = counters_for<T>();
+    counters.bytes_relocated.fetch_add(n * sizeof(T), std::memory_order_relaxed);
+    if constexpr (Ranges::relocates_bitwise_v<Alloc, T>)
+        counters.elements_relocated_bitwise.fetch_add(n, std::memory_order_relaxed);
+    else if constexpr (Ranges::strong_guarantee_moves_v<T>)
+        counters.elements_moved.fetch_add(n, std::memory_order_relaxed);
+    else
+        counters.elements_copied.fetch_add(n, std::memory_order_relaxed);
+}
+
+#endif
+
+inline Snapshot snapshot(const std::string& tag) {return Registry::instance().snapshot(tag);}
+
+template<typename T>
+Snapshot snapshot() {return snapshot(type_tag<T>::name());}
+
+inline void dump(std::ostream& os) {Registry::instance().dump(os);}
+
+inline void reset() {Registry::instance().reset();}
+
+} // namespace Container::Instrumentation
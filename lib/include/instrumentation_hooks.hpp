@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+
+//the hooks Container::Vector calls on allocations and relocations: empty unless VECTOR_INSTRUMENTATION is defined,
+//then they come from instrumentation.hpp and count per element type
+namespace Container::Instrumentation
+{
+
+#ifdef VECTOR_INSTRUMENTATION
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+//what made a vector move to a new block
+enum class Reallocation
+{
+    reserve,
+    resize,
+    shrink_to_fit,
+    growth, //push_back, emplace and insert
+};
+
+#ifndef VECTOR_INSTRUMENTATION
+
+template<typename T>
+constexpr void record_allocation(std::size_t) {}
+
+template<typename T>
+constexpr void record_reallocation(Reallocation) {}
+
+template<typename T, typename Alloc>
+constexpr void record_relocation(std::size_t) {}
+
+#endif
+
+} // namespace Container::Instrumentation
+
+#ifdef VECTOR_INSTRUMENTATION
+#include "instrumentation.hpp"
+#endif
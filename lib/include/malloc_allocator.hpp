@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace Container
+{
+
+//malloc-backed allocator that reports the usable size of its blocks through allocate_at_least
+template<typename T>
+class MallocAllocator
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "MallocAllocator does not support over-aligned types");
+public:
+    using value_type = T;
+
+    struct allocation_result
+    {
+        T* ptr;
+        std::size_t count;
+    };
+
+    MallocAllocator() = default;
+
+    template<typename U>
+    MallocAllocator(const MallocAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+        auto ptr = std::malloc(n * sizeof(T));
+        if (!ptr)
+            throw std::bad_alloc{};
+        return static_cast<T*>(ptr);
+    }
+
+    allocation_result allocate_at_least(std::size_t n)
+    {
+        auto ptr = allocate(n);
+        return {ptr, ::malloc_usable_size(ptr) / sizeof(T)};
+    }
+
+    void deallocate(T* ptr, std::size_t) noexcept {std::free(ptr);}
+
+    friend bool operator==(const MallocAllocator&, const MallocAllocator&) noexcept {return true;}
+};
+
+} // namespace Container
@@ -0,0 +1,337 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include "vector.hpp"
+
+namespace Container
+{
+
+//Vector of trivially copyable elements that live in a shared mapping of a file: a fixed header followed by
+//the elements. The file is the capacity; growth extends it with ftruncate and maps it again.
+//Opening an existing file is a single mmap, whatever its size; writes reach the file through the page cache
+//and flush() makes them durable.
+template<typename T, typename GrowthPolicy = Growth::Doubling>
+class MappedVector final
+{
+    static_assert(std::is_trivially_copyable<T>::value, "MappedVector stores the bytes of its elements");
+public:
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+
+    using iterator       = detail::iterator<pointer>;
+    using const_iterator = detail::iterator<const_pointer>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    enum class open_mode
+    {
+        create,     //truncates an existing file
+        read_write,
+        read_only,
+    };
+
+private:
+    struct header
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t element_size;
+        std::uint64_t element_align;
+        std::uint64_t size;
+    };
+
+    static constexpr std::uint64_t format_magic   = 0x524f544345564d43; //"CMVECTOR"
+    static constexpr std::uint32_t format_version = 1;
+    //elements start on a cache line, the mapping itself is page aligned
+    static constexpr size_type data_offset = std::max<size_type>(64, alignof(T));
+    static_assert(sizeof(header) <= data_offset);
+
+    int fd_ = -1;
+    bool writable_ = false;
+    std::byte* map_ = nullptr;
+    size_type capacity_ = 0;
+
+public:
+    explicit MappedVector(const std::filesystem::path& path, open_mode mode = open_mode::read_write)
+    :writable_ {mode != open_mode::read_only}
+    {
+        int flags = (mode == open_mode::read_only) ? O_RDONLY :
+                    (mode == open_mode::create)    ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR;
+        fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+            throw std::system_error{errno, std::generic_category(), "can't open " + path.string()};
+
+        try
+        {
+            if (mode == open_mode::create)
+            {
+                resize_file(data_offset);
+                map_ = map(data_offset);
+                *get_header() = header{format_magic, format_version, sizeof(T), alignof(T), 0};
+            }
+            else
+                open_existing();
+        }
+        catch (...)
+        {
+            close();
+            throw;
+        }
+    }
+
+    //the moved-from vector is empty and read-only, it maps no file
+    MappedVector(MappedVector&& rhs) noexcept {swap(rhs);}
+
+    MappedVector& operator=(MappedVector&& rhs) noexcept
+    {
+        MappedVector tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    MappedVector(const MappedVector&)            = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    //unmaps without msync; the kernel still writes the pages back eventually
+    ~MappedVector() {close();}
+
+    void swap(MappedVector& rhs) noexcept
+    {
+        std::swap(fd_, rhs.fd_);
+        std::swap(writable_, rhs.writable_);
+        std::swap(map_, rhs.map_);
+        std::swap(capacity_, rhs.capacity_);
+    }
+
+    friend void swap(MappedVector& lhs, MappedVector& rhs) noexcept {lhs.swap(rhs);}
+
+private:
+    header* get_header() const noexcept {return reinterpret_cast<header*>(map_);}
+
+    size_type mapped_bytes() const noexcept {return data_offset + capacity_ * sizeof(T);}
+
+    void close() noexcept
+    {
+        if (map_)
+            ::munmap(map_, mapped_bytes());
+        if (fd_ >= 0)
+            ::close(fd_);
+        map_ = nullptr;
+        fd_ = -1;
+        capacity_ = 0;
+    }
+
+    void resize_file(size_type bytes)
+    {
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0)
+            throw std::system_error{errno, std::generic_category(), "can't resize mapped file"};
+    }
+
+    std::byte* map(size_type bytes) const
+    {
+        int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+        auto ptr = ::mmap(nullptr, bytes, prot, MAP_SHARED, fd_, 0);
+        if (ptr == MAP_FAILED)
+            throw std::system_error{errno, std::generic_category(), "can't map file"};
+        return static_cast<std::byte*>(ptr);
+    }
+
+    void open_existing()
+    {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0)
+            throw std::system_error{errno, std::generic_category(), "can't stat mapped file"};
+        auto file_size = static_cast<size_type>(st.st_size);
+        if (file_size < data_offset)
+            throw std::runtime_error{"mapped file is too short for a header"};
+
+        auto capacity = (file_size - data_offset) / sizeof(T);
+        map_ = map(data_offset + capacity * sizeof(T));
+        capacity_ = capacity;
+
+        auto hdr = get_header();
+        if (hdr->magic != format_magic || hdr->version != format_version)
+            throw std::runtime_error{"mapped file has an unknown format"};
+        if (hdr->element_size != sizeof(T) || hdr->element_align != alignof(T))
+            throw std::runtime_error{"mapped file holds elements of another type"};
+        if (hdr->size > capacity_)
+            throw std::runtime_error{"mapped file is truncated"};
+    }
+
+    void check_writable() const
+    {
+        if (!writable_)
+            throw std::logic_error{"try to modify read-only MappedVector"};
+    }
+
+    //new mapping is made before the old one goes, so the vector is intact if it fails
+    void remap(size_type new_capacity)
+    {
+        auto old_bytes = mapped_bytes(), new_bytes = data_offset + new_capacity * sizeof(T);
+        if (new_bytes > old_bytes)
+            resize_file(new_bytes);
+        auto new_map = map(new_bytes);
+        ::munmap(map_, old_bytes);
+        map_ = new_map;
+        capacity_ = new_capacity;
+        if (new_bytes < old_bytes)
+            resize_file(new_bytes);
+    }
+
+    void set_size(size_type size) noexcept {get_header()->size = size;}
+
+public:
+    size_type size() const {return map_ ? get_header()->size : 0;}
+    size_type capacity() const {return capacity_;}
+    bool empty() const {return size() == 0;}
+    bool read_only() const {return !writable_;}
+    pointer data() {return map_ ? reinterpret_cast<pointer>(map_ + data_offset) : nullptr;}
+    const_pointer data() const {return map_ ? reinterpret_cast<const_pointer>(map_ + data_offset) : nullptr;}
+
+    reference       operator[](size_type index)       noexcept {return data()[index];}
+    const_reference operator[](size_type index) const noexcept {return data()[index];}
+
+    reference at(size_type index)
+    {
+        if (index >= size())
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return data()[index];
+    }
+    const_reference at(size_type index) const
+    {
+        if (index >= size())
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return data()[index];
+    }
+
+    reference front()
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return data()[0];
+    }
+    const_reference front() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return data()[0];
+    }
+
+    reference back()
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return data()[size() - 1];
+    }
+    const_reference back() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return data()[size() - 1];
+    }
+
+    void reserve(size_type newsz)
+    {
+        check_writable();
+        if (newsz > capacity_)
+            remap(newsz);
+    }
+
+    void push_back(const value_type& val) {emplace_back(val);}
+
+    //args may refer to elements of the vector itself
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        check_writable();
+        auto used = size();
+        if (used == capacity_)
+        {
+            value_type tmp (std::forward<Args>(args)...);
+            remap(std::max(GrowthPolicy::next_capacity(capacity_, used + 1, sizeof(T)), used + 1));
+            std::construct_at(data() + used, tmp);
+        }
+        else
+            std::construct_at(data() + used, std::forward<Args>(args)...);
+        set_size(used + 1);
+        return data()[used];
+    }
+
+    void pop_back()
+    {
+        check_writable();
+        if (empty())
+            throw std::underflow_error{"try to pop element from empty vector"};
+        set_size(size() - 1);
+    }
+
+    void resize(size_type newsz) {resize(newsz, value_type{});}
+
+    //value may refer to an element of the vector itself, which a remap unmaps
+    void resize(size_type newsz, const_reference value)
+    {
+        value_type tmp = value;
+        reserve(newsz);
+        auto used = size();
+        if (newsz > used)
+            std::uninitialized_fill(data() + used, data() + newsz, tmp);
+        set_size(newsz);
+    }
+
+    void clear()
+    {
+        check_writable();
+        set_size(0);
+    }
+
+    //gives the unused tail of the file back
+    void shrink_to_fit()
+    {
+        check_writable();
+        if (size() != capacity_)
+            remap(size());
+    }
+
+    //blocks until the elements and the size are on disk
+    void flush()
+    {
+        if (!map_)
+            return;
+        if (::msync(map_, mapped_bytes(), MS_SYNC) != 0)
+            throw std::system_error{errno, std::generic_category(), "can't flush mapped file"};
+    }
+
+    iterator begin() {return iterator{data()};}
+    iterator end()   {return iterator{data() + size()};}
+
+    const_iterator begin() const {return const_iterator{data()};}
+    const_iterator end()   const {return const_iterator{data() + size()};}
+
+    const_iterator cbegin() const {return const_iterator{data()};}
+    const_iterator cend()   const {return const_iterator{data() + size()};}
+
+    reverse_iterator rbegin() {return reverse_iterator{end()};}
+    reverse_iterator rend()   {return reverse_iterator{begin()};}
+
+    const_reverse_iterator rbegin() const {return const_reverse_iterator{end()};}
+    const_reverse_iterator rend()   const {return const_reverse_iterator{begin()};}
+
+    const_reverse_iterator crbegin() const {return const_reverse_iterator{cend()};}
+    const_reverse_iterator crend()   const {return const_reverse_iterator{cbegin()};}
+}; // class MappedVector
+
+} // namespace Container
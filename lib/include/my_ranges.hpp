@@ -1,9 +1,14 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <memory_resource>
 #include <iterator>
+#include <type_traits>
 
 namespace Ranges
 {
-//give a strong guarantee if value_type is copy constructible 
+//give a strong guarantee if value_type is copy constructible
 template<typename InpIt, typename NoThrFwdIt>
 constexpr NoThrFwdIt strong_guarantee_uninitialized_move_or_copy(InpIt first, InpIt last, NoThrFwdIt d_first)
 {
@@ -11,7 +16,7 @@ constexpr NoThrFwdIt strong_guarantee_uninitialized_move_or_copy(InpIt first, In
     if constexpr (!std::is_copy_constructible<value_type>::value || std::is_nothrow_move_constructible<value_type>::value)
         return std::uninitialized_move(first, last, d_first);
     else
-        return std::uninitialized_copy(first, last, d_first);   
+        return std::uninitialized_copy(first, last, d_first);
 }
 
 template<typename FwdIt>
@@ -23,4 +28,249 @@ constexpr void uninitialized_default_construct(FwdIt first, FwdIt last)
     else
         std::uninitialized_default_construct(first, last);
 }
-} // namespace Ranges
\ No newline at end of file
+
+namespace detail
+{
+template<typename Alloc>
+struct is_polymorphic_allocator: std::false_type {};
+
+template<typename U>
+struct is_polymorphic_allocator<std::pmr::polymorphic_allocator<U>>: std::true_type {};
+} // namespace detail
+
+//allocator_traits<Alloc>::construct/destroy are equivalent to placement new and a destructor call,
+//so the allocator-aware algorithms below may fall back to the std ones
+template<typename Alloc, typename T>
+inline constexpr bool has_plain_construct_v =
+    (!requires (Alloc& alloc, T* ptr) {alloc.destroy(ptr);} &&
+     !requires (Alloc& alloc, T* ptr, T&& val) {alloc.construct(ptr, std::move(val));}) ||
+    (detail::is_polymorphic_allocator<Alloc>::value && std::is_trivially_copyable<T>::value && !std::uses_allocator<T, Alloc>::value);
+
+template<typename Alloc, typename FwdIt>
+constexpr void destroy(Alloc& alloc, FwdIt first, FwdIt last)
+{
+    using value_type = typename std::iterator_traits<FwdIt>::value_type;
+    if constexpr (has_plain_construct_v<Alloc, value_type>)
+        std::destroy(first, last);
+    else
+        for (; first != last; ++first)
+            std::allocator_traits<Alloc>::destroy(alloc, std::addressof(*first));
+}
+
+template<typename Alloc, typename InpIt, typename FwdIt>
+constexpr FwdIt uninitialized_copy(Alloc& alloc, InpIt first, InpIt last, FwdIt d_first)
+{
+    using value_type = typename std::iterator_traits<FwdIt>::value_type;
+    if constexpr (has_plain_construct_v<Alloc, value_type>)
+    {
+        if (!std::is_constant_evaluated())
+            return std::uninitialized_copy(first, last, d_first);
+    }
+    auto current = d_first;
+    try
+    {
+        for (; first != last; ++first, ++current)
+            std::allocator_traits<Alloc>::construct(alloc, std::addressof(*current), *first);
+    }
+    catch (...)
+    {
+        Ranges::destroy(alloc, d_first, current);
+        throw;
+    }
+    return current;
+}
+
+template<typename Alloc, typename InpIt, typename FwdIt>
+constexpr FwdIt uninitialized_move(Alloc& alloc, InpIt first, InpIt last, FwdIt d_first)
+{
+    using value_type = typename std::iterator_traits<FwdIt>::value_type;
+    if constexpr (has_plain_construct_v<Alloc, value_type>)
+    {
+        if (!std::is_constant_evaluated())
+            return std::uninitialized_move(first, last, d_first);
+    }
+    return Ranges::uninitialized_copy(alloc, std::make_move_iterator(first), std::make_move_iterator(last), d_first);
+}
+
+template<typename Alloc, typename FwdIt, typename T>
+constexpr void uninitialized_fill(Alloc& alloc, FwdIt first, FwdIt last, const T& val)
+{
+    using value_type = typename std::iterator_traits<FwdIt>::value_type;
+    if constexpr (has_plain_construct_v<Alloc, value_type>)
+    {
+        if (!std::is_constant_evaluated())
+            return std::uninitialized_fill(first, last, val);
+    }
+    auto current = first;
+    try
+    {
+        for (; current != last; ++current)
+            std::allocator_traits<Alloc>::construct(alloc, std::addressof(*current), val);
+    }
+    catch (...)
+    {
+        Ranges::destroy(alloc, first, current);
+        throw;
+    }
+}
+
+template<typename Alloc, typename FwdIt>
+constexpr void uninitialized_default_construct(Alloc& alloc, FwdIt first, FwdIt last)
+{
+    using value_type = typename std::iterator_traits<FwdIt>::value_type;
+    if constexpr (has_plain_construct_v<Alloc, value_type>)
+    {
+        if (!std::is_constant_evaluated())
+            return Ranges::uninitialized_default_construct(first, last);
+    }
+    auto current = first;
+    try
+    {
+        for (; current != last; ++current)
+            std::allocator_traits<Alloc>::construct(alloc, std::addressof(*current));
+    }
+    catch (...)
+    {
+        Ranges::destroy(alloc, first, current);
+        throw;
+    }
+}
+
+//default-initialization: trivially default constructible elements are left uninitialized
+template<typename Alloc, typename FwdIt>
+constexpr void uninitialized_default_init(Alloc& alloc, FwdIt first, FwdIt last)
+{
+    using value_type = typename std::iterator_traits<FwdIt>::value_type;
+    //indeterminate values cannot be read in constant evaluation, so they are value-initialized there
+    if constexpr (has_plain_construct_v<Alloc, value_type> || std::is_trivially_default_constructible<value_type>::value)
+    {
+        if (!std::is_constant_evaluated())
+            return std::uninitialized_default_construct(first, last);
+    }
+    Ranges::uninitialized_default_construct(alloc, first, last);
+}
+
+//strong_guarantee_uninitialized_move_or_copy moves rather than copies T
+template<typename T>
+inline constexpr bool strong_guarantee_moves_v = !std::is_copy_constructible<T>::value || std::is_nothrow_move_constructible<T>::value;
+
+template<typename Alloc, typename InpIt, typename NoThrFwdIt>
+constexpr NoThrFwdIt strong_guarantee_uninitialized_move_or_copy(Alloc& alloc, InpIt first, InpIt last, NoThrFwdIt d_first)
+{
+    using value_type = typename std::iterator_traits<InpIt>::value_type;
+    if constexpr (strong_guarantee_moves_v<value_type>)
+        return Ranges::uninitialized_move(alloc, first, last, d_first);
+    else
+        return Ranges::uninitialized_copy(alloc, first, last, d_first);
+}
+
+//a type is trivially relocatable if moving it to new storage and destroying the source
+//is equivalent to copying its bytes; specialize for types that opt in
+template<typename T>
+struct is_trivially_relocatable: std::is_trivially_copyable<T> {};
+
+template<typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>>: is_trivially_relocatable<D> {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+//uninitialized_relocate copies the bytes of T
+template<typename Alloc, typename T>
+inline constexpr bool relocates_bitwise_v = is_trivially_relocatable_v<T> && has_plain_construct_v<Alloc, T>;
+
+//moves [first, last) to d_first and ends the lifetime of the source objects;
+//falls back to strong_guarantee_uninitialized_move_or_copy, so the source is left intact on exception
+template<typename Alloc, typename T>
+constexpr T* uninitialized_relocate(Alloc& alloc, T* first, T* last, T* d_first)
+{
+    if constexpr (relocates_bitwise_v<Alloc, T>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            if (first != last)
+                std::memcpy(static_cast<void*>(d_first), static_cast<const void*>(first), sizeof(T) * (last - first));
+            return d_first + (last - first);
+        }
+    }
+    auto d_last = Ranges::strong_guarantee_uninitialized_move_or_copy(alloc, first, last, d_first);
+    Ranges::destroy(alloc, first, last);
+    return d_last;
+}
+
+//relocates [first, last) to d_first within the same block, the ranges may overlap; for types that relocate bitwise,
+//with memmove, or element by element in constant evaluation, where the bytes of objects cannot be copied
+template<typename Alloc, typename T>
+constexpr void relocate_overlapping(Alloc& alloc, T* first, T* last, T* d_first)
+{
+    static_assert(relocates_bitwise_v<Alloc, T>, "relocate_overlapping is for types that relocate bitwise");
+    if (!std::is_constant_evaluated())
+    {
+        if (first != last)
+            std::memmove(static_cast<void*>(d_first), static_cast<const void*>(first), sizeof(T) * (last - first));
+        return;
+    }
+    if (d_first < first)
+    {
+        for (; first != last; ++first, ++d_first)
+        {
+            std::allocator_traits<Alloc>::construct(alloc, d_first, std::move(*first));
+            std::allocator_traits<Alloc>::destroy(alloc, first);
+        }
+    }
+    else
+    {
+        for (auto d_last = d_first + (last - first); last != first;)
+        {
+            std::allocator_traits<Alloc>::construct(alloc, --d_last, std::move(*--last));
+            std::allocator_traits<Alloc>::destroy(alloc, last);
+        }
+    }
+}
+//copy and equal that go down to memmove and memcmp on contiguous ranges of trivially copyable elements,
+//which the std versions only do for raw pointers; other iterators use the std ones
+template<typename InpIt, typename OutIt>
+constexpr OutIt copy(InpIt first, InpIt last, OutIt d_first)
+{
+    if constexpr (std::contiguous_iterator<InpIt> && std::contiguous_iterator<OutIt>)
+    {
+        using value_type = std::iter_value_t<InpIt>;
+        if constexpr (std::is_same<value_type, std::iter_value_t<OutIt>>::value &&
+                      std::is_trivially_copyable<value_type>::value &&
+                      std::is_assignable<std::iter_reference_t<OutIt>, std::iter_reference_t<InpIt>>::value)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                auto n = last - first;
+                if (n > 0)
+                    std::memmove(static_cast<void*>(std::to_address(d_first)),
+                                 static_cast<const void*>(std::to_address(first)), sizeof(value_type) * n);
+                return d_first + n;
+            }
+        }
+    }
+    return std::copy(first, last, d_first);
+}
+
+template<typename InpIt1, typename InpIt2>
+constexpr bool equal(InpIt1 first1, InpIt1 last1, InpIt2 first2, InpIt2 last2)
+{
+    if constexpr (std::contiguous_iterator<InpIt1> && std::contiguous_iterator<InpIt2>)
+    {
+        using value_type = std::iter_value_t<InpIt1>;
+        //equal values have equal bytes
+        if constexpr (std::is_same<value_type, std::iter_value_t<InpIt2>>::value &&
+                      std::has_unique_object_representations<value_type>::value)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                auto n = last1 - first1;
+                if (n != last2 - first2)
+                    return false;
+                return n == 0 || std::memcmp(std::to_address(first1), std::to_address(first2), sizeof(value_type) * n) == 0;
+            }
+        }
+    }
+    return std::equal(first1, last1, first2, last2);
+}
+} // namespace Ranges
@@ -0,0 +1,516 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "vector.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_NUMERIC_X86 1
+#endif
+
+//opt-in element-wise arithmetic and reductions over Vectors of arithmetic types.
+//b * c + d builds an expression that is evaluated in a single pass by assign(), eval() or a compound assignment,
+//without intermediate Vectors; expressions refer to their operands, so they must not outlive them.
+//sum, dot, min and max of float and double run SIMD kernels picked at runtime among SSE2, AVX2 and AVX-512
+namespace Container::Numeric
+{
+
+namespace detail
+{
+template<typename V>
+struct is_vector: std::false_type {};
+
+template<typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+struct is_vector<Vector<T, Allocator, GrowthPolicy, Storage>>: std::true_type {};
+} // namespace detail
+
+template<typename V>
+concept ArithmeticVector = detail::is_vector<V>::value && std::is_arithmetic<typename V::value_type>::value;
+
+struct expression_base {};
+
+template<typename E>
+concept Expression = std::derived_from<E, expression_base>;
+
+template<typename X>
+concept Operand = ArithmeticVector<X> || Expression<X> || std::is_arithmetic<X>::value;
+
+//elements of a Vector
+template<typename T>
+class vector_ref: public expression_base
+{
+    const T* data_;
+    std::size_t size_;
+
+public:
+    using value_type = T;
+    static constexpr bool sized = true;
+
+    vector_ref(const T* data, std::size_t size): data_ {data}, size_ {size} {}
+
+    std::size_t size() const {return size_;}
+    T operator[](std::size_t index) const {return data_[index];}
+};
+
+//scalar broadcast to every index
+template<typename T>
+class scalar_ref: public expression_base
+{
+    T val_;
+
+public:
+    using value_type = T;
+    static constexpr bool sized = false;
+
+    explicit scalar_ref(T val): val_ {val} {}
+
+    T operator[](std::size_t) const {return val_;}
+};
+
+template<typename Op, typename E>
+class unary_expr: public expression_base
+{
+    E expr_;
+
+public:
+    using value_type = decltype(Op{}(std::declval<typename E::value_type>()));
+    static constexpr bool sized = E::sized;
+
+    explicit unary_expr(const E& expr): expr_ {expr} {}
+
+    std::size_t size() const requires sized {return expr_.size();}
+    value_type operator[](std::size_t index) const {return Op{}(expr_[index]);}
+};
+
+template<typename Op, typename L, typename R>
+class binary_expr: public expression_base
+{
+    L lhs_;
+    R rhs_;
+
+public:
+    using value_type = decltype(Op{}(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+    static constexpr bool sized = L::sized || R::sized;
+
+    binary_expr(const L& lhs, const R& rhs): lhs_ {lhs}, rhs_ {rhs}
+    {
+        if constexpr (L::sized && R::sized)
+        {
+            if (lhs_.size() != rhs_.size())
+                throw std::invalid_argument{"element-wise operation on vectors of different sizes"};
+        }
+    }
+
+    std::size_t size() const requires sized
+    {
+        if constexpr (L::sized)
+            return lhs_.size();
+        else
+            return rhs_.size();
+    }
+
+    value_type operator[](std::size_t index) const {return Op{}(lhs_[index], rhs_[index]);}
+};
+
+template<Operand X>
+auto to_expr(const X& operand)
+{
+    if constexpr (Expression<X>)
+        return operand;
+    else if constexpr (std::is_arithmetic<X>::value)
+        return scalar_ref<X>{operand};
+    else
+        return vector_ref<typename X::value_type>{operand.data(), operand.size()};
+}
+
+//at least one side is a vector or an expression
+template<typename L, typename R>
+concept OperandPair = Operand<L> && Operand<R> && !(std::is_arithmetic<L>::value && std::is_arithmetic<R>::value);
+
+template<typename L, typename R>
+requires OperandPair<L, R>
+auto operator+(const L& lhs, const R& rhs)
+{
+    return binary_expr<std::plus<>, decltype(to_expr(lhs)), decltype(to_expr(rhs))>{to_expr(lhs), to_expr(rhs)};
+}
+
+template<typename L, typename R>
+requires OperandPair<L, R>
+auto operator-(const L& lhs, const R& rhs)
+{
+    return binary_expr<std::minus<>, decltype(to_expr(lhs)), decltype(to_expr(rhs))>{to_expr(lhs), to_expr(rhs)};
+}
+
+template<typename L, typename R>
+requires OperandPair<L, R>
+auto operator*(const L& lhs, const R& rhs)
+{
+    return binary_expr<std::multiplies<>, decltype(to_expr(lhs)), decltype(to_expr(rhs))>{to_expr(lhs), to_expr(rhs)};
+}
+
+template<typename L, typename R>
+requires OperandPair<L, R>
+auto operator/(const L& lhs, const R& rhs)
+{
+    return binary_expr<std::divides<>, decltype(to_expr(lhs)), decltype(to_expr(rhs))>{to_expr(lhs), to_expr(rhs)};
+}
+
+template<typename X>
+requires (ArithmeticVector<X> || Expression<X>)
+auto operator-(const X& operand)
+{
+    return unary_expr<std::negate<>, decltype(to_expr(operand))>{to_expr(operand)};
+}
+
+namespace detail
+{
+template<typename Vec, typename X, typename Op>
+Vec& compound_assign(Vec& dst, const X& src, Op op)
+{
+    auto expr = to_expr(src);
+    if constexpr (decltype(expr)::sized)
+    {
+        if (expr.size() != dst.size())
+            throw std::invalid_argument{"element-wise operation on vectors of different sizes"};
+    }
+    auto out = dst.data();
+    for (std::size_t i = 0, size = dst.size(); i < size; i++)
+        out[i] = static_cast<typename Vec::value_type>(op(out[i], expr[i]));
+    return dst;
+}
+} // namespace detail
+
+//dst = src in one pass; dst takes the size of src, or keeps its own if src is a scalar.
+//dst may appear in src, element i of dst only depends on element i of the operands
+template<ArithmeticVector Vec, Operand X>
+Vec& assign(Vec& dst, const X& src)
+{
+    auto expr = to_expr(src);
+    if constexpr (decltype(expr)::sized)
+        dst.resize_for_overwrite(expr.size());
+    auto out = dst.data();
+    for (std::size_t i = 0, size = dst.size(); i < size; i++)
+        out[i] = static_cast<typename Vec::value_type>(expr[i]);
+    return dst;
+}
+
+template<Expression E>
+Vector<typename E::value_type> eval(const E& expr)
+{
+    Vector<typename E::value_type> result;
+    assign(result, expr);
+    return result;
+}
+
+template<ArithmeticVector Vec, Operand X>
+Vec& operator+=(Vec& dst, const X& src) {return detail::compound_assign(dst, src, std::plus<>{});}
+
+template<ArithmeticVector Vec, Operand X>
+Vec& operator-=(Vec& dst, const X& src) {return detail::compound_assign(dst, src, std::minus<>{});}
+
+template<ArithmeticVector Vec, Operand X>
+Vec& operator*=(Vec& dst, const X& src) {return detail::compound_assign(dst, src, std::multiplies<>{});}
+
+template<ArithmeticVector Vec, Operand X>
+Vec& operator/=(Vec& dst, const X& src) {return detail::compound_assign(dst, src, std::divides<>{});}
+
+enum class Isa
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512,
+};
+
+inline bool supported(Isa isa) noexcept
+{
+#ifdef VECTOR_NUMERIC_X86
+    __builtin_cpu_init();
+    switch (isa)
+    {
+        case Isa::scalar: return true;
+        case Isa::sse2:   return __builtin_cpu_supports("sse2");
+        case Isa::avx2:   return __builtin_cpu_supports("avx2");
+        case Isa::avx512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return isa == Isa::scalar;
+#endif
+}
+
+//widest instruction set of this CPU
+inline Isa best_isa() noexcept
+{
+    static const Isa isa = []
+    {
+        for (auto candidate : {Isa::avx512, Isa::avx2, Isa::sse2})
+            if (supported(candidate))
+                return candidate;
+        return Isa::scalar;
+    }();
+    return isa;
+}
+
+template<typename T>
+struct Kernels
+{
+    T (*sum)(const T*, std::size_t);
+    T (*dot)(const T*, const T*, std::size_t);
+    T (*min)(const T*, std::size_t);
+    T (*max)(const T*, std::size_t);
+};
+
+namespace detail
+{
+
+template<typename T>
+T scalar_sum(const T* ptr, std::size_t n)
+{
+    T acc {};
+    for (std::size_t i = 0; i < n; i++)
+        acc += ptr[i];
+    return acc;
+}
+
+template<typename T>
+T scalar_dot(const T* lhs, const T* rhs, std::size_t n)
+{
+    T acc {};
+    for (std::size_t i = 0; i < n; i++)
+        acc += lhs[i] * rhs[i];
+    return acc;
+}
+
+//n > 0
+template<bool Max, typename T>
+T scalar_extreme(const T* ptr, std::size_t n)
+{
+    T acc = ptr[0];
+    for (std::size_t i = 1; i < n; i++)
+        acc = (Max ? acc < ptr[i] : ptr[i] < acc) ? ptr[i] : acc;
+    return acc;
+}
+
+#ifdef VECTOR_NUMERIC_X86
+//kernel bodies are written once with GCC vector extensions and always inlined into the per-ISA entry points
+//below, whose target attribute decides whether a Bytes-wide vector becomes xmm, ymm or zmm registers
+template<typename T, std::size_t Bytes>
+[[gnu::always_inline]] inline T simd_sum(const T* ptr, std::size_t n)
+{
+    typedef T vec __attribute__((vector_size(Bytes)));
+    constexpr std::size_t width = Bytes / sizeof(T);
+    vec acc[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 * width <= n; i += 4 * width)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            vec val;
+            std::memcpy(&val, ptr + i + k * width, sizeof(vec));
+            acc[k] += val;
+        }
+    }
+    acc[0] += acc[1] + acc[2] + acc[3];
+    T result {};
+    for (std::size_t k = 0; k < width; k++)
+        result += acc[0][k];
+    for (; i < n; i++)
+        result += ptr[i];
+    return result;
+}
+
+template<typename T, std::size_t Bytes>
+[[gnu::always_inline]] inline T simd_dot(const T* lhs, const T* rhs, std::size_t n)
+{
+    typedef T vec __attribute__((vector_size(Bytes)));
+    constexpr std::size_t width = Bytes / sizeof(T);
+    vec acc[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 * width <= n; i += 4 * width)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            vec left, right;
+            std::memcpy(&left, lhs + i + k * width, sizeof(vec));
+            std::memcpy(&right, rhs + i + k * width, sizeof(vec));
+            acc[k] += left * right;
+        }
+    }
+    acc[0] += acc[1] + acc[2] + acc[3];
+    T result {};
+    for (std::size_t k = 0; k < width; k++)
+        result += acc[0][k];
+    for (; i < n; i++)
+        result += lhs[i] * rhs[i];
+    return result;
+}
+
+//n > 0
+template<bool Max, typename T, std::size_t Bytes>
+[[gnu::always_inline]] inline T simd_extreme(const T* ptr, std::size_t n)
+{
+    typedef T vec __attribute__((vector_size(Bytes)));
+    constexpr std::size_t width = Bytes / sizeof(T);
+    if (n < width)
+        return scalar_extreme<Max>(ptr, n);
+
+    vec acc;
+    std::memcpy(&acc, ptr, sizeof(vec));
+    std::size_t i = width;
+    for (; i + width <= n; i += width)
+    {
+        vec val;
+        std::memcpy(&val, ptr + i, sizeof(vec));
+        acc = (Max ? acc < val : val < acc) ? val : acc;
+    }
+    T result = acc[0];
+    for (std::size_t k = 1; k < width; k++)
+        result = (Max ? result < acc[k] : acc[k] < result) ? acc[k] : result;
+    for (; i < n; i++)
+        result = (Max ? result < ptr[i] : ptr[i] < result) ? ptr[i] : result;
+    return result;
+}
+
+template<typename T, std::size_t Bytes>
+struct simd_entry;
+
+template<typename T>
+struct simd_entry<T, 16>
+{
+    [[gnu::target("sse2")]] static T sum(const T* ptr, std::size_t n) {return simd_sum<T, 16>(ptr, n);}
+    [[gnu::target("sse2")]] static T dot(const T* lhs, const T* rhs, std::size_t n) {return simd_dot<T, 16>(lhs, rhs, n);}
+    [[gnu::target("sse2")]] static T min(const T* ptr, std::size_t n) {return simd_extreme<false, T, 16>(ptr, n);}
+    [[gnu::target("sse2")]] static T max(const T* ptr, std::size_t n) {return simd_extreme<true, T, 16>(ptr, n);}
+};
+
+template<typename T>
+struct simd_entry<T, 32>
+{
+    [[gnu::target("avx2")]] static T sum(const T* ptr, std::size_t n) {return simd_sum<T, 32>(ptr, n);}
+    [[gnu::target("avx2")]] static T dot(const T* lhs, const T* rhs, std::size_t n) {return simd_dot<T, 32>(lhs, rhs, n);}
+    [[gnu::target("avx2")]] static T min(const T* ptr, std::size_t n) {return simd_extreme<false, T, 32>(ptr, n);}
+    [[gnu::target("avx2")]] static T max(const T* ptr, std::size_t n) {return simd_extreme<true, T, 32>(ptr, n);}
+};
+
+template<typename T>
+struct simd_entry<T, 64>
+{
+    [[gnu::target("avx512f")]] static T sum(const T* ptr, std::size_t n) {return simd_sum<T, 64>(ptr, n);}
+    [[gnu::target("avx512f")]] static T dot(const T* lhs, const T* rhs, std::size_t n) {return simd_dot<T, 64>(lhs, rhs, n);}
+    [[gnu::target("avx512f")]] static T min(const T* ptr, std::size_t n) {return simd_extreme<false, T, 64>(ptr, n);}
+    [[gnu::target("avx512f")]] static T max(const T* ptr, std::size_t n) {return simd_extreme<true, T, 64>(ptr, n);}
+};
+
+template<typename T, std::size_t Bytes>
+inline constexpr Kernels<T> simd_kernels {&simd_entry<T, Bytes>::sum, &simd_entry<T, Bytes>::dot,
+                                          &simd_entry<T, Bytes>::min, &simd_entry<T, Bytes>::max};
+#endif
+
+template<typename T>
+inline constexpr Kernels<T> scalar_kernels {&scalar_sum<T>, &scalar_dot<T>, &scalar_extreme<false, T>, &scalar_extreme<true, T>};
+
+} // namespace detail
+
+template<typename T>
+concept SimdArithmetic = std::same_as<T, float> || std::same_as<T, double>;
+
+//kernels of one instruction set; throws std::invalid_argument if this CPU does not support it
+template<SimdArithmetic T>
+const Kernels<T>& kernels(Isa isa)
+{
+    if (!supported(isa))
+        throw std::invalid_argument{"instruction set is not supported by this CPU"};
+#ifdef VECTOR_NUMERIC_X86
+    switch (isa)
+    {
+        case Isa::scalar: return detail::scalar_kernels<T>;
+        case Isa::sse2:   return detail::simd_kernels<T, 16>;
+        case Isa::avx2:   return detail::simd_kernels<T, 32>;
+        case Isa::avx512: return detail::simd_kernels<T, 64>;
+    }
+#endif
+    return detail::scalar_kernels<T>;
+}
+
+//kernels of best_isa()
+template<SimdArithmetic T>
+const Kernels<T>& kernels()
+{
+    static const Kernels<T>& best = kernels<T>(best_isa());
+    return best;
+}
+
+template<ArithmeticVector Vec>
+typename Vec::value_type sum(const Vec& vec)
+{
+    using T = typename Vec::value_type;
+    if constexpr (SimdArithmetic<T>)
+        return kernels<T>().sum(vec.data(), vec.size());
+    else
+        return detail::scalar_sum(vec.data(), vec.size());
+}
+
+template<Expression E>
+typename E::value_type sum(const E& expr) requires E::sized
+{
+    typename E::value_type acc {};
+    for (std::size_t i = 0, size = expr.size(); i < size; i++)
+        acc += expr[i];
+    return acc;
+}
+
+template<ArithmeticVector Vec>
+typename Vec::value_type dot(const Vec& lhs, const Vec& rhs)
+{
+    using T = typename Vec::value_type;
+    if (lhs.size() != rhs.size())
+        throw std::invalid_argument{"dot product of vectors of different sizes"};
+    if constexpr (SimdArithmetic<T>)
+        return kernels<T>().dot(lhs.data(), rhs.data(), lhs.size());
+    else
+        return detail::scalar_dot(lhs.data(), rhs.data(), lhs.size());
+}
+
+//NaNs are not ordered, the result with NaNs in vec depends on the instruction set
+template<ArithmeticVector Vec>
+typename Vec::value_type min(const Vec& vec)
+{
+    using T = typename Vec::value_type;
+    if (vec.empty())
+        throw std::underflow_error{"try to get min of empty vector"};
+    if constexpr (SimdArithmetic<T>)
+        return kernels<T>().min(vec.data(), vec.size());
+    else
+        return detail::scalar_extreme<false>(vec.data(), vec.size());
+}
+
+template<ArithmeticVector Vec>
+typename Vec::value_type max(const Vec& vec)
+{
+    using T = typename Vec::value_type;
+    if (vec.empty())
+        throw std::underflow_error{"try to get max of empty vector"};
+    if constexpr (SimdArithmetic<T>)
+        return kernels<T>().max(vec.data(), vec.size());
+    else
+        return detail::scalar_extreme<true>(vec.data(), vec.size());
+}
+
+} // namespace Container::Numeric
+
+namespace Container
+{
+//found by argument-dependent lookup on Vectors
+using Numeric::operator+;
+using Numeric::operator-;
+using Numeric::operator*;
+using Numeric::operator/;
+using Numeric::operator+=;
+using Numeric::operator-=;
+using Numeric::operator*=;
+using Numeric::operator/=;
+} // namespace Container
@@ -0,0 +1,131 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Container
+{
+
+namespace os
+{
+
+inline std::size_t page_size() noexcept
+{
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+inline std::size_t round_to_pages(std::size_t bytes) noexcept
+{
+    auto page = page_size();
+    return (bytes + page - 1) / page * page;
+}
+
+inline void* map_anonymous(std::size_t bytes, int extra_flags = 0) noexcept
+{
+    auto ptr = ::mmap(nullptr, round_to_pages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return (ptr == MAP_FAILED) ? nullptr : ptr;
+}
+
+inline void unmap(void* ptr, std::size_t bytes) noexcept
+{
+    ::munmap(ptr, round_to_pages(bytes));
+}
+
+//grows or shrinks a mapping, letting the kernel move the pages instead of copying them
+inline void* remap(void* ptr, std::size_t old_bytes, std::size_t new_bytes) noexcept
+{
+    auto old_size = round_to_pages(old_bytes), new_size = round_to_pages(new_bytes);
+    if (old_size == new_size)
+        return ptr;
+#if defined(__linux__)
+    auto new_ptr = ::mremap(ptr, old_size, new_size, MREMAP_MAYMOVE);
+    return (new_ptr == MAP_FAILED) ? nullptr : new_ptr;
+#else
+    auto new_ptr = map_anonymous(new_size);
+    if (!new_ptr)
+        return nullptr;
+    std::memcpy(new_ptr, ptr, (old_size < new_size) ? old_size : new_size);
+    ::munmap(ptr, old_size);
+    return new_ptr;
+#endif
+}
+
+//size of the default huge page, 2 MiB if the kernel does not tell
+inline std::size_t huge_page_size() noexcept
+{
+    static const std::size_t size = []
+    {
+        std::size_t kb = 0;
+#if defined(__linux__)
+        std::ifstream meminfo {"/proc/meminfo"};
+        std::string key;
+        while (meminfo >> key)
+        {
+            if (key == "Hugepagesize:")
+            {
+                meminfo >> kb;
+                break;
+            }
+            meminfo.ignore(256, '\n');
+        }
+#endif
+        return (kb != 0) ? kb * 1024 : std::size_t{1} << 21;
+    }();
+    return size;
+}
+
+inline std::size_t round_to_huge_pages(std::size_t bytes) noexcept
+{
+    auto page = huge_page_size();
+    return (bytes + page - 1) / page * page;
+}
+
+//maps whole huge pages: MAP_HUGETLB if the kernel has reserved pages, otherwise ordinary pages
+//aligned to the huge page size and advised for transparent huge pages; release with unmap_huge
+inline void* map_huge(std::size_t bytes) noexcept
+{
+    auto size = round_to_huge_pages(bytes), page = huge_page_size();
+#if defined(MAP_HUGETLB)
+    if (auto ptr = map_anonymous(size, MAP_HUGETLB))
+        return ptr;
+#endif
+    auto raw = static_cast<char*>(map_anonymous(size + page));
+    if (!raw)
+        return nullptr;
+    auto aligned = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(raw) + page - 1) / page * page);
+    if (aligned != raw)
+        ::munmap(raw, aligned - raw);
+    if (auto tail = (raw + size + page) - (aligned + size))
+        ::munmap(aligned + size, tail);
+#if defined(MADV_HUGEPAGE)
+    ::madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+
+inline void unmap_huge(void* ptr, std::size_t bytes) noexcept
+{
+    ::munmap(ptr, round_to_huge_pages(bytes));
+}
+
+//gives the whole pages of [ptr, ptr + bytes) back to the OS; the range stays mapped and reads as zeros.
+//page is the page size of the mapping: MAP_HUGETLB mappings can only drop whole huge pages.
+//false if the kernel refused
+inline bool discard(void* ptr, std::size_t bytes, std::size_t page = page_size()) noexcept
+{
+    auto first = (reinterpret_cast<std::uintptr_t>(ptr) + page - 1) / page * page;
+    auto last  = (reinterpret_cast<std::uintptr_t>(ptr) + bytes) / page * page;
+    if (first >= last)
+        return true;
+    return ::madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED) == 0;
+}
+
+} // namespace os
+
+} // namespace Container
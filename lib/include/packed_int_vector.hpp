@@ -0,0 +1,374 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include "index_iterator.hpp"
+#include "numeric.hpp"
+#include "vector.hpp"
+
+#ifdef VECTOR_NUMERIC_X86
+#include <immintrin.h>
+#endif
+
+namespace Container
+{
+
+//writes base + value j of a block packed at width bits, for j in [first, first + n), to out
+using UnpackKernel = void (*)(const std::uint64_t* block, unsigned width, std::uint64_t base,
+                              std::size_t first, std::size_t n, std::uint64_t* out);
+
+namespace detail
+{
+
+constexpr std::uint64_t low_bits(unsigned width) noexcept
+{
+    return width == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << width) - 1;
+}
+
+//value j of a block packed at width > 0 bits
+inline std::uint64_t unpack_one(const std::uint64_t* block, unsigned width, std::size_t j) noexcept
+{
+    auto bit = j * width;
+    auto word = bit / 64, shift = bit % 64;
+    auto val = block[word] >> shift;
+    if (shift + width > 64)
+        val |= block[word + 1] << (64 - shift);
+    return val & low_bits(width);
+}
+
+inline void scalar_unpack(const std::uint64_t* block, unsigned width, std::uint64_t base,
+                          std::size_t first, std::size_t n, std::uint64_t* out)
+{
+    if (width == 0)
+        return std::fill(out, out + n, base);
+    for (std::size_t i = 0; i < n; i++)
+        out[i] = base + unpack_one(block, width, first + i);
+}
+
+#ifdef VECTOR_NUMERIC_X86
+//every lane gathers the word its value starts in and the next one and funnel shifts them;
+//vpsllvq by 64 gives zero, so values within one word need no branch. Blocks are followed by a readable word
+[[gnu::target("avx2")]] inline void avx2_unpack(const std::uint64_t* block, unsigned width, std::uint64_t base,
+                                                std::size_t first, std::size_t n, std::uint64_t* out)
+{
+    if (width == 0)
+        return std::fill(out, out + n, base);
+    auto words = reinterpret_cast<const long long*>(block);
+    const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(low_bits(width)));
+    const __m256i bases = _mm256_set1_epi64x(static_cast<long long>(base));
+    const __m256i sixty_four = _mm256_set1_epi64x(64), six_bits = _mm256_set1_epi64x(63), one = _mm256_set1_epi64x(1);
+    const __m256i step = _mm256_set1_epi64x(static_cast<long long>(4 * width));
+    __m256i bits = _mm256_setr_epi64x(first * width, (first + 1) * width, (first + 2) * width, (first + 3) * width);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        auto word = _mm256_srli_epi64(bits, 6);
+        auto shift = _mm256_and_si256(bits, six_bits);
+        auto lo = _mm256_i64gather_epi64(words, word, 8);
+        auto hi = _mm256_i64gather_epi64(words, _mm256_add_epi64(word, one), 8);
+        auto val = _mm256_or_si256(_mm256_srlv_epi64(lo, shift), _mm256_sllv_epi64(hi, _mm256_sub_epi64(sixty_four, shift)));
+        val = _mm256_add_epi64(_mm256_and_si256(val, mask), bases);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), val);
+        bits = _mm256_add_epi64(bits, step);
+    }
+    for (; i < n; i++)
+        out[i] = base + unpack_one(block, width, first + i);
+}
+
+[[gnu::target("avx512f,avx512dq")]] inline void avx512_unpack(const std::uint64_t* block, unsigned width, std::uint64_t base,
+                                                     std::size_t first, std::size_t n, std::uint64_t* out)
+{
+    if (width == 0)
+        return std::fill(out, out + n, base);
+    const __m512i mask = _mm512_set1_epi64(static_cast<long long>(low_bits(width)));
+    const __m512i bases = _mm512_set1_epi64(static_cast<long long>(base));
+    const __m512i sixty_four = _mm512_set1_epi64(64), six_bits = _mm512_set1_epi64(63), one = _mm512_set1_epi64(1);
+    const __m512i step = _mm512_set1_epi64(static_cast<long long>(8 * width));
+    __m512i bits = _mm512_mullo_epi64(_mm512_add_epi64(_mm512_set1_epi64(first), _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7)),
+                                      _mm512_set1_epi64(width));
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        auto word = _mm512_srli_epi64(bits, 6);
+        auto shift = _mm512_and_si512(bits, six_bits);
+        auto lo = _mm512_i64gather_epi64(word, block, 8);
+        auto hi = _mm512_i64gather_epi64(_mm512_add_epi64(word, one), block, 8);
+        auto val = _mm512_or_si512(_mm512_srlv_epi64(lo, shift), _mm512_sllv_epi64(hi, _mm512_sub_epi64(sixty_four, shift)));
+        val = _mm512_add_epi64(_mm512_and_si512(val, mask), bases);
+        _mm512_storeu_si512(out + i, val);
+        bits = _mm512_add_epi64(bits, step);
+    }
+    for (; i < n; i++)
+        out[i] = base + unpack_one(block, width, first + i);
+}
+#endif
+
+} // namespace detail
+
+//unpack kernel of one instruction set; throws std::invalid_argument if this CPU does not support it.
+//SSE2 has no per-lane shifts, so it gets the scalar kernel
+inline UnpackKernel unpack_kernel(Numeric::Isa isa)
+{
+    using Numeric::Isa;
+    if (!Numeric::supported(isa))
+        throw std::invalid_argument{"instruction set is not supported by this CPU"};
+#ifdef VECTOR_NUMERIC_X86
+    switch (isa)
+    {
+        case Isa::scalar:
+        case Isa::sse2:   return &detail::scalar_unpack;
+        case Isa::avx2:   return &detail::avx2_unpack;
+        case Isa::avx512: return __builtin_cpu_supports("avx512dq") ? &detail::avx512_unpack : &detail::avx2_unpack;
+    }
+#endif
+    return &detail::scalar_unpack;
+}
+
+//unpack kernel of Numeric::best_isa()
+inline UnpackKernel unpack_kernel()
+{
+    static const UnpackKernel best = unpack_kernel(Numeric::best_isa());
+    return best;
+}
+
+//append-only vector of integers compressed by frame of reference: every block of block_size values keeps its
+//minimum and the differences from it at the fewest bits that hold them all, so blocks of small or clustered values
+//take a fraction of their plain size. Indexing is O(1), one header lookup and at most two words read; decode()
+//unpacks runs of values with SIMD kernels. The last, unfinished block stays unpacked until it fills up
+template<std::integral T = std::uint64_t, typename Allocator = std::allocator<std::uint64_t>>
+class PackedIntVector final
+{
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = std::size_t;
+    using const_reference = T;
+    using const_iterator  = detail::index_iterator<PackedIntVector, const T, T>;
+    using iterator        = const_iterator;
+
+    static constexpr size_type block_size = 128;
+
+private:
+    static_assert(std::is_same<typename std::allocator_traits<Allocator>::value_type, std::uint64_t>::value,
+                  "PackedIntVector packs into std::uint64_t words");
+
+    struct block_header
+    {
+        std::uint64_t base;
+        //word offset of the block << 8 | width in bits
+        std::uint64_t location;
+
+        std::size_t offset() const noexcept {return location >> 8;}
+        unsigned width() const noexcept {return location & 0xff;}
+    };
+
+    using header_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<block_header>;
+
+    //packed blocks back to back, a block of width w takes 2 * w words; one zero word follows the last block,
+    //so kernels may read a word past any value
+    Vector<std::uint64_t, Allocator> words_;
+    Vector<block_header, header_allocator> headers_;
+    std::array<T, block_size> pending_ {};
+    size_type pending_count_ = 0;
+
+    static std::uint64_t to_bits(T val) noexcept {return static_cast<std::uint64_t>(val);}
+
+    //packs the full pending block; nothing changes if it throws
+    void flush()
+    {
+        auto [lo, hi] = std::minmax_element(pending_.begin(), pending_.end());
+        auto base = to_bits(*lo);
+        auto width = static_cast<unsigned>(std::bit_width(to_bits(*hi) - base));
+
+        std::uint64_t packed[2 * 64] = {};
+        for (size_type j = 0; j < block_size && width; j++)
+        {
+            auto delta = to_bits(pending_[j]) - base;
+            auto bit = j * width;
+            auto word = bit / 64, shift = bit % 64;
+            packed[word] |= delta << shift;
+            if (shift + width > 64)
+                packed[word + 1] |= delta >> (64 - shift);
+        }
+
+        const std::uint64_t sentinel[1] = {0};
+        if (words_.empty())
+            words_.insert(words_.end(), sentinel, sentinel + 1);
+        auto offset = words_.size() - 1;
+        headers_.push_back(block_header{base, offset << 8 | width});
+        if (width)
+        {
+            //the sentinel becomes the first word of the block and a new one is appended
+            try
+            {
+                words_.insert(words_.end(), packed + 1, packed + 2 * width);
+                words_.insert(words_.end(), sentinel, sentinel + 1);
+            }
+            catch (...)
+            {
+                words_.resize(offset + 1);
+                headers_.pop_back();
+                throw;
+            }
+            words_[offset] = packed[0];
+        }
+        pending_count_ = 0;
+    }
+
+    void check_range(size_type first, size_type count) const
+    {
+        if (first > size() || count > size() - first)
+            throw std::out_of_range{"try to get slice out of array"};
+    }
+
+public:
+    PackedIntVector() = default;
+    explicit PackedIntVector(const allocator_type& alloc): words_ (alloc), headers_ (header_allocator(alloc)) {}
+
+    explicit PackedIntVector(std::span<const T> values, const allocator_type& alloc = allocator_type())
+    :PackedIntVector(alloc)
+    {
+        append(values);
+    }
+
+    allocator_type get_allocator() const {return words_.get_allocator();}
+
+    size_type size() const noexcept {return headers_.size() * block_size + pending_count_;}
+    bool empty() const noexcept {return size() == 0;}
+
+    //bytes of the packed words, block headers and pending block
+    size_type memory_bytes() const noexcept
+    {
+        return words_.capacity() * sizeof(std::uint64_t) + headers_.capacity() * sizeof(block_header) + sizeof(pending_);
+    }
+
+    //bits of the block holding index; the pending block reports the bits of T
+    unsigned width_at(size_type index) const noexcept
+    {
+        auto block = index / block_size;
+        return block < headers_.size() ? headers_[block].width() : sizeof(T) * 8;
+    }
+
+    const_reference operator[](size_type index) const noexcept
+    {
+        auto block = index / block_size;
+        if (block == headers_.size())
+            return pending_[index % block_size];
+        auto& header = headers_[block];
+        auto width = header.width();
+        auto delta = width ? detail::unpack_one(words_.data() + header.offset(), width, index % block_size) : 0;
+        return static_cast<T>(header.base + delta);
+    }
+
+    const_reference at(size_type index) const
+    {
+        if (index >= size())
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return (*this)[index];
+    }
+
+    const_reference front() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return (*this)[0];
+    }
+
+    const_reference back() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return (*this)[size() - 1];
+    }
+
+    //strong guarantee
+    void push_back(T val)
+    {
+        pending_[pending_count_++] = val;
+        if (pending_count_ < block_size)
+            return;
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+            pending_count_--;
+            throw;
+        }
+    }
+
+    //basic guarantee, the values appended before an exception stay
+    void append(std::span<const T> values)
+    {
+        headers_.reserve(headers_.size() + (pending_count_ + values.size()) / block_size);
+        for (auto val : values)
+            push_back(val);
+    }
+
+    void clear() noexcept
+    {
+        words_.clear();
+        headers_.clear();
+        pending_count_ = 0;
+    }
+
+    void shrink_to_fit()
+    {
+        words_.shrink_to_fit();
+        headers_.shrink_to_fit();
+    }
+
+    //values [first, first + out.size()) into out; throws std::out_of_range past the end
+    void decode(size_type first, std::span<T> out, UnpackKernel kernel = unpack_kernel()) const
+    {
+        check_range(first, out.size());
+        auto dst = out.data();
+        auto last = first + out.size();
+        std::uint64_t buf[block_size];
+        while (first < last)
+        {
+            auto block = first / block_size, in_block = first % block_size;
+            auto n = std::min(block_size - in_block, last - first);
+            if (block == headers_.size())
+                dst = std::copy_n(pending_.data() + in_block, n, dst);
+            else
+            {
+                auto& header = headers_[block];
+                auto block_words = words_.data() + header.offset();
+                //the unsigned variant of T may alias it
+                if constexpr (std::is_same<std::make_unsigned_t<T>, std::uint64_t>::value)
+                    kernel(block_words, header.width(), header.base, in_block, n, reinterpret_cast<std::uint64_t*>(dst));
+                else
+                {
+                    kernel(block_words, header.width(), header.base, in_block, n, buf);
+                    std::transform(buf, buf + n, dst, [](std::uint64_t val){return static_cast<T>(val);});
+                }
+                dst += n;
+            }
+            first += n;
+        }
+    }
+
+    Vector<T> to_vector() const
+    {
+        Vector<T> vec (size(), default_init);
+        decode(0, {vec.data(), vec.size()});
+        return vec;
+    }
+
+    const_iterator begin() const noexcept {return const_iterator{this, 0};}
+    const_iterator end()   const noexcept {return const_iterator{this, size()};}
+
+    const_iterator cbegin() const noexcept {return begin();}
+    const_iterator cend()   const noexcept {return end();}
+}; // class PackedIntVector
+
+} // namespace Container
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+
+namespace Container
+{
+
+class ThreadPool;
+
+//tag for the parallel overloads of the Ranges algorithms and of Vector:
+//elements are constructed on the pool (ThreadPool::instance() if none), in chunks of about grain_bytes,
+//so every page is first touched by the thread that fills it.
+//allocator_traits::construct must be safe to call concurrently.
+//The algorithms and the pool are in parallel_ranges.hpp, which code using them includes
+struct parallel_policy
+{
+    ThreadPool* pool = nullptr;
+    std::size_t grain_bytes = std::size_t{1} << 18;
+
+    inline ThreadPool& get_pool() const;
+};
+
+inline constexpr parallel_policy par {};
+
+} // namespace Container
+
+//declared here for Vector's parallel constructors and resize, defined in parallel_ranges.hpp
+namespace Ranges
+{
+
+template<typename Alloc, std::random_access_iterator RandIt, std::random_access_iterator FwdIt>
+FwdIt uninitialized_copy(const Container::parallel_policy& policy, Alloc& alloc, RandIt first, RandIt last, FwdIt d_first);
+
+template<typename Alloc, std::random_access_iterator RandIt, std::random_access_iterator FwdIt>
+FwdIt uninitialized_move(const Container::parallel_policy& policy, Alloc& alloc, RandIt first, RandIt last, FwdIt d_first);
+
+template<typename Alloc, std::random_access_iterator FwdIt, typename T>
+void uninitialized_fill(const Container::parallel_policy& policy, Alloc& alloc, FwdIt first, FwdIt last, const T& val);
+
+template<typename Alloc, std::random_access_iterator FwdIt>
+void uninitialized_default_construct(const Container::parallel_policy& policy, Alloc& alloc, FwdIt first, FwdIt last);
+
+} // namespace Ranges
@@ -0,0 +1,92 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include "my_ranges.hpp"
+#include "thread_pool.hpp"
+
+//parallel overloads of the allocator-aware uninitialized algorithms: the destination is split into chunks,
+//each chunk is built by the serial algorithm, which rolls itself back on exception,
+//and if any chunk fails the chunks that were completed are destroyed before the first exception is rethrown
+namespace Ranges
+{
+
+namespace detail
+{
+
+//construct(dst_first, dst_last, offset) builds [dst_first, dst_last), offset elements from d_first
+template<typename Alloc, typename RandIt, typename Construct>
+void parallel_construct(const Container::parallel_policy& policy, Alloc& alloc, RandIt d_first, std::size_t n,
+                        Construct construct)
+{
+    using value_type = typename std::iterator_traits<RandIt>::value_type;
+    auto& pool = policy.get_pool();
+    auto max_chunks = 4 * (pool.size() + 1);
+    auto chunks = std::min(max_chunks, n * sizeof(value_type) / std::max<std::size_t>(policy.grain_bytes, 1));
+    if (chunks <= 1)
+        return construct(d_first, d_first + n, 0);
+
+    auto bounds = [n, chunks](std::size_t chunk){return n / chunks * chunk + std::min(chunk, n % chunks);};
+    auto built = std::make_unique<bool[]>(chunks);
+    auto errors = std::make_unique<std::exception_ptr[]>(chunks);
+    pool.run(chunks, [&](std::size_t chunk)
+    {
+        auto first = bounds(chunk), last = bounds(chunk + 1);
+        try
+        {
+            construct(d_first + first, d_first + last, first);
+            built[chunk] = true;
+        }
+        catch (...)
+        {
+            errors[chunk] = std::current_exception();
+        }
+    });
+
+    for (std::size_t chunk = 0; chunk < chunks; chunk++)
+    {
+        if (!errors[chunk])
+            continue;
+        for (std::size_t done = 0; done < chunks; done++)
+            if (built[done])
+                Ranges::destroy(alloc, d_first + bounds(done), d_first + bounds(done + 1));
+        std::rethrow_exception(errors[chunk]);
+    }
+}
+
+} // namespace detail
+
+template<typename Alloc, std::random_access_iterator RandIt, std::random_access_iterator FwdIt>
+FwdIt uninitialized_copy(const Container::parallel_policy& policy, Alloc& alloc, RandIt first, RandIt last, FwdIt d_first)
+{
+    auto n = static_cast<std::size_t>(last - first);
+    detail::parallel_construct(policy, alloc, d_first, n, [&alloc, first](FwdIt dst, FwdIt dst_last, std::size_t offset)
+    {
+        Ranges::uninitialized_copy(alloc, first + offset, first + offset + (dst_last - dst), dst);
+    });
+    return d_first + n;
+}
+
+template<typename Alloc, std::random_access_iterator RandIt, std::random_access_iterator FwdIt>
+FwdIt uninitialized_move(const Container::parallel_policy& policy, Alloc& alloc, RandIt first, RandIt last, FwdIt d_first)
+{
+    return Ranges::uninitialized_copy(policy, alloc, std::make_move_iterator(first), std::make_move_iterator(last), d_first);
+}
+
+template<typename Alloc, std::random_access_iterator FwdIt, typename T>
+void uninitialized_fill(const Container::parallel_policy& policy, Alloc& alloc, FwdIt first, FwdIt last, const T& val)
+{
+    detail::parallel_construct(policy, alloc, first, static_cast<std::size_t>(last - first),
+        [&alloc, &val](FwdIt dst, FwdIt dst_last, std::size_t){Ranges::uninitialized_fill(alloc, dst, dst_last, val);});
+}
+
+template<typename Alloc, std::random_access_iterator FwdIt>
+void uninitialized_default_construct(const Container::parallel_policy& policy, Alloc& alloc, FwdIt first, FwdIt last)
+{
+    detail::parallel_construct(policy, alloc, first, static_cast<std::size_t>(last - first),
+        [&alloc](FwdIt dst, FwdIt dst_last, std::size_t){Ranges::uninitialized_default_construct(alloc, dst, dst_last);});
+}
+
+} // namespace Ranges
@@ -0,0 +1,1188 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "vector.hpp"
+
+namespace Container
+{
+
+namespace detail
+{
+
+inline constexpr std::size_t rrb_bits      = 5;
+inline constexpr std::size_t rrb_branching = std::size_t{1} << rrb_bits;
+//a rebalanced node may keep this many more children than the optimum, which bounds the search in relaxed nodes
+inline constexpr std::size_t rrb_extras    = 2;
+
+struct rrb_node
+{
+    std::atomic<std::uint32_t> refs {1};
+    //children or elements in use
+    std::uint32_t count = 0;
+    //elements in the subtree
+    std::size_t size = 0;
+};
+
+template<typename T>
+struct rrb_leaf: rrb_node
+{
+    union
+    {
+        T elems[rrb_branching];
+    };
+
+    rrb_leaf() {}
+    ~rrb_leaf() {}
+};
+
+struct rrb_inner: rrb_node
+{
+    //sizes is only read when relaxed, a regular node has every child but the last one full
+    bool relaxed = false;
+    rrb_node* children[rrb_branching];
+    std::size_t sizes[rrb_branching];
+};
+
+//relaxed radix balanced tree of reference counted nodes plus a tail leaf, the shared representation of
+//PersistentVector and TransientVector. Nodes are modified in place only when this tree is their only owner,
+//anything shared is copied first, so modifications never show through other trees.
+//shift_ is the height of root_ times rrb_bits, leaves have shift 0
+template<typename T, typename Allocator>
+class rrb_tree
+{
+    using leaf = rrb_leaf<T>;
+    using node = rrb_node;
+    using inner = rrb_inner;
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using leaf_allocator  = typename alloc_traits::template rebind_alloc<leaf>;
+    using inner_allocator = typename alloc_traits::template rebind_alloc<inner>;
+
+public:
+    [[no_unique_address]] Allocator alloc_;
+    node* root_ = nullptr;
+    std::size_t shift_ = 0;
+    leaf* tail_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    rrb_tree() = default;
+    explicit rrb_tree(const Allocator& alloc): alloc_ {alloc} {}
+
+    rrb_tree(const rrb_tree& rhs)
+    :alloc_ {rhs.alloc_}, root_ {retain(rhs.root_)}, shift_ {rhs.shift_}, tail_ {retain(rhs.tail_)}, size_ {rhs.size_}
+    {}
+
+    rrb_tree(rrb_tree&& rhs) noexcept
+    :alloc_ {rhs.alloc_}, root_ {std::exchange(rhs.root_, nullptr)}, shift_ {std::exchange(rhs.shift_, 0)},
+     tail_ {std::exchange(rhs.tail_, nullptr)}, size_ {std::exchange(rhs.size_, 0)}
+    {}
+
+    rrb_tree& operator=(rrb_tree rhs) noexcept
+    {
+        swap(rhs);
+        return *this;
+    }
+
+    ~rrb_tree()
+    {
+        release(root_, shift_);
+        release(tail_, 0);
+    }
+
+    void swap(rrb_tree& rhs) noexcept
+    {
+        using std::swap;
+        swap(alloc_, rhs.alloc_);
+        swap(root_, rhs.root_);
+        swap(shift_, rhs.shift_);
+        swap(tail_, rhs.tail_);
+        swap(size_, rhs.size_);
+    }
+
+    std::size_t tail_offset() const {return size_ - (tail_ ? tail_->count : 0);}
+
+private:
+    template<typename N>
+    static N* retain(N* ptr) noexcept
+    {
+        if (ptr)
+            ptr->refs.fetch_add(1, std::memory_order_relaxed);
+        return ptr;
+    }
+
+    //the other owners dropped the node with release decrements, their reads happen before our writes
+    static bool unique(const node* ptr) noexcept {return ptr->refs.load(std::memory_order_acquire) == 1;}
+
+    static leaf* as_leaf(node* ptr) noexcept {return static_cast<leaf*>(ptr);}
+    static const leaf* as_leaf(const node* ptr) noexcept {return static_cast<const leaf*>(ptr);}
+    static inner* as_inner(node* ptr) noexcept {return static_cast<inner*>(ptr);}
+    static const inner* as_inner(const node* ptr) noexcept {return static_cast<const inner*>(ptr);}
+
+    leaf* new_leaf()
+    {
+        leaf_allocator alloc {alloc_};
+        auto ptr = std::allocator_traits<leaf_allocator>::allocate(alloc, 1);
+        return std::construct_at(ptr);
+    }
+
+    inner* new_inner()
+    {
+        inner_allocator alloc {alloc_};
+        auto ptr = std::allocator_traits<inner_allocator>::allocate(alloc, 1);
+        return std::construct_at(ptr);
+    }
+
+    void free_leaf(leaf* ptr) noexcept
+    {
+        Ranges::destroy(alloc_, ptr->elems, ptr->elems + ptr->count);
+        std::destroy_at(ptr);
+        leaf_allocator alloc {alloc_};
+        std::allocator_traits<leaf_allocator>::deallocate(alloc, ptr, 1);
+    }
+
+    void free_inner(inner* ptr, std::size_t shift) noexcept
+    {
+        for (std::uint32_t i = 0; i < ptr->count; i++)
+            release(ptr->children[i], shift - rrb_bits);
+        std::destroy_at(ptr);
+        inner_allocator alloc {alloc_};
+        std::allocator_traits<inner_allocator>::deallocate(alloc, ptr, 1);
+    }
+
+public:
+    void release(node* ptr, std::size_t shift) noexcept
+    {
+        if (!ptr || ptr->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        if (shift == 0)
+            free_leaf(as_leaf(ptr));
+        else
+            free_inner(as_inner(ptr), shift);
+    }
+
+private:
+    //new leaf with copies of elements [first, last) of src
+    leaf* leaf_from(const leaf* src, std::size_t first, std::size_t last)
+    {
+        auto dst = new_leaf();
+        try
+        {
+            Ranges::uninitialized_copy(alloc_, src->elems + first, src->elems + last, dst->elems);
+        }
+        catch (...)
+        {
+            free_leaf(dst);
+            throw;
+        }
+        dst->count = dst->size = last - first;
+        return dst;
+    }
+
+    inner* inner_from(const inner* src)
+    {
+        auto dst = new_inner();
+        dst->count = src->count;
+        dst->size = src->size;
+        dst->relaxed = src->relaxed;
+        for (std::uint32_t i = 0; i < src->count; i++)
+        {
+            dst->children[i] = retain(src->children[i]);
+            dst->sizes[i] = src->sizes[i];
+        }
+        return dst;
+    }
+
+    //the node in slot becomes exclusive to this tree
+    template<typename N>
+    void make_unique(N*& slot, std::size_t shift)
+    {
+        if (unique(slot))
+            return;
+        N* copy;
+        if (shift == 0)
+            copy = static_cast<N*>(static_cast<node*>(leaf_from(as_leaf(slot), 0, slot->count)));
+        else
+            copy = static_cast<N*>(static_cast<node*>(inner_from(as_inner(slot))));
+        release(slot, shift);
+        slot = copy;
+    }
+
+    //recomputes size, sizes and relaxed from the children
+    static void update_sizes(inner* ptr, std::size_t shift) noexcept
+    {
+        std::size_t total = 0;
+        bool relaxed = false;
+        for (std::uint32_t i = 0; i < ptr->count; i++)
+        {
+            auto child_size = ptr->children[i]->size;
+            total += child_size;
+            ptr->sizes[i] = total;
+            if (i + 1 < ptr->count && child_size != (std::size_t{1} << shift))
+                relaxed = true;
+        }
+        ptr->size = total;
+        ptr->relaxed = relaxed;
+    }
+
+    //slot of the child holding index, index becomes relative to that child
+    static std::uint32_t find_slot(const inner* ptr, std::size_t shift, std::size_t& index) noexcept
+    {
+        auto slot = static_cast<std::uint32_t>(index >> shift);
+        if (ptr->relaxed)
+        {
+            while (ptr->sizes[slot] <= index)
+                slot++;
+            index -= slot ? ptr->sizes[slot - 1] : 0;
+        }
+        else
+            index -= std::size_t{slot} << shift;
+        return slot;
+    }
+
+public:
+    //leaf holding index and the index of its first element
+    std::pair<const leaf*, std::size_t> leaf_for(std::size_t index) const noexcept
+    {
+        auto offset = tail_offset();
+        if (index >= offset)
+            return {tail_, offset};
+
+        auto start = index;
+        const node* ptr = root_;
+        for (auto shift = shift_; shift > 0; shift -= rrb_bits)
+        {
+            auto in = as_inner(ptr);
+            ptr = in->children[find_slot(in, shift, index)];
+        }
+        return {as_leaf(ptr), start - index};
+    }
+
+    const T& operator[](std::size_t index) const noexcept
+    {
+        auto [ptr, start] = leaf_for(index);
+        return ptr->elems[index - start];
+    }
+
+    //fn(elems, count) for every leaf in order
+    template<typename Fn>
+    void for_each_leaf(Fn&& fn) const
+    {
+        if (root_)
+            for_each_leaf(root_, shift_, fn);
+        if (tail_)
+            fn(static_cast<const T*>(tail_->elems), std::size_t{tail_->count});
+    }
+
+private:
+    template<typename Fn>
+    static void for_each_leaf(const node* ptr, std::size_t shift, Fn& fn)
+    {
+        if (shift == 0)
+            return fn(static_cast<const T*>(as_leaf(ptr)->elems), std::size_t{ptr->count});
+        auto in = as_inner(ptr);
+        for (std::uint32_t i = 0; i < in->count; i++)
+            for_each_leaf(in->children[i], shift - rrb_bits, fn);
+    }
+
+public:
+    template<typename U>
+    void set(std::size_t index, U&& val)
+    {
+        auto offset = tail_offset();
+        if (index >= offset)
+        {
+            make_unique(tail_, 0);
+            tail_->elems[index - offset] = std::forward<U>(val);
+            return;
+        }
+
+        make_unique(root_, shift_);
+        node** slot = &root_;
+        for (auto shift = shift_; shift > 0; shift -= rrb_bits)
+        {
+            auto in = as_inner(*slot);
+            slot = &in->children[find_slot(in, shift, index)];
+            make_unique(*slot, shift - rrb_bits);
+        }
+        as_leaf(*slot)->elems[index] = std::forward<U>(val);
+    }
+
+    //args may refer to elements of the tree
+    template<typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (tail_ && tail_->count < rrb_branching)
+        {
+            make_unique(tail_, 0);
+            std::allocator_traits<Allocator>::construct(alloc_, tail_->elems + tail_->count, std::forward<Args>(args)...);
+            tail_->count++;
+            tail_->size++;
+            size_++;
+            return;
+        }
+
+        auto next = new_leaf();
+        try
+        {
+            std::allocator_traits<Allocator>::construct(alloc_, next->elems, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            free_leaf(next);
+            throw;
+        }
+        next->count = next->size = 1;
+        if (tail_)
+        {
+            try
+            {
+                push_leaf(tail_);
+            }
+            catch (...)
+            {
+                release(next, 0);
+                throw;
+            }
+            release(tail_, 0);
+        }
+        tail_ = next;
+        size_++;
+    }
+
+    void pop_back()
+    {
+        if (tail_->count > 1)
+        {
+            make_unique(tail_, 0);
+            tail_->count--;
+            tail_->size--;
+            Ranges::destroy(alloc_, tail_->elems + tail_->count, tail_->elems + tail_->count + 1);
+            size_--;
+            return;
+        }
+        take(size_ - 1);
+    }
+
+private:
+    //has the subtree room for one more leaf
+    static bool has_room(const node* ptr, std::size_t shift) noexcept
+    {
+        if (shift == 0)
+            return false;
+        auto in = as_inner(ptr);
+        return in->count < rrb_branching || has_room(in->children[in->count - 1], shift - rrb_bits);
+    }
+
+    //a chain of single-child nodes from shift down to ptr
+    node* new_path(node* ptr, std::size_t shift)
+    {
+        if (shift == 0)
+            return retain(ptr);
+        auto child = new_path(ptr, shift - rrb_bits);
+        inner* in;
+        try
+        {
+            in = new_inner();
+        }
+        catch (...)
+        {
+            release(child, shift - rrb_bits);
+            throw;
+        }
+        in->children[0] = child;
+        in->count = 1;
+        update_sizes(in, shift);
+        return in;
+    }
+
+    void append_leaf(node*& slot, std::size_t shift, leaf* ptr)
+    {
+        make_unique(slot, shift);
+        auto in = as_inner(slot);
+        if (shift == rrb_bits)
+            in->children[in->count++] = retain(ptr);
+        else if (has_room(in->children[in->count - 1], shift - rrb_bits))
+            append_leaf(in->children[in->count - 1], shift - rrb_bits, ptr);
+        else
+        {
+            in->children[in->count] = new_path(ptr, shift - rrb_bits);
+            in->count++;
+        }
+        update_sizes(in, shift);
+    }
+
+    //links a leaf, which may be partially filled, after the last element of the tree
+    void push_leaf(leaf* ptr)
+    {
+        if (!root_)
+        {
+            root_ = retain(ptr);
+            shift_ = 0;
+        }
+        else if (has_room(root_, shift_))
+            append_leaf(root_, shift_, ptr);
+        else
+        {
+            auto path = new_path(ptr, shift_);
+            inner* top;
+            try
+            {
+                top = new_inner();
+            }
+            catch (...)
+            {
+                release(path, shift_);
+                throw;
+            }
+            top->children[0] = root_;
+            top->children[1] = path;
+            top->count = 2;
+            shift_ += rrb_bits;
+            update_sizes(top, shift_);
+            root_ = top;
+        }
+    }
+
+    //first n elements of the subtree, 0 < n <= size
+    node* take_tree(node* ptr, std::size_t shift, std::size_t n)
+    {
+        if (n == ptr->size)
+            return retain(ptr);
+        if (shift == 0)
+            return leaf_from(as_leaf(ptr), 0, n);
+
+        auto in = as_inner(ptr);
+        auto index = n - 1;
+        auto slot = find_slot(in, shift, index);
+        auto child = take_tree(in->children[slot], shift - rrb_bits, index + 1);
+        auto result = new_inner_or_release(child, shift - rrb_bits);
+        for (std::uint32_t i = 0; i < slot; i++)
+            result->children[i] = retain(in->children[i]);
+        result->children[slot] = child;
+        result->count = slot + 1;
+        update_sizes(result, shift);
+        return result;
+    }
+
+    //elements [n, size) of the subtree, 0 <= n < size
+    node* drop_tree(node* ptr, std::size_t shift, std::size_t n)
+    {
+        if (n == 0)
+            return retain(ptr);
+        if (shift == 0)
+            return leaf_from(as_leaf(ptr), n, ptr->count);
+
+        auto in = as_inner(ptr);
+        auto index = n;
+        auto slot = find_slot(in, shift, index);
+        auto child = drop_tree(in->children[slot], shift - rrb_bits, index);
+        auto result = new_inner_or_release(child, shift - rrb_bits);
+        result->children[0] = child;
+        for (std::uint32_t i = slot + 1; i < in->count; i++)
+            result->children[i - slot] = retain(in->children[i]);
+        result->count = in->count - slot;
+        update_sizes(result, shift);
+        return result;
+    }
+
+    inner* new_inner_or_release(node* owned, std::size_t shift)
+    {
+        try
+        {
+            return new_inner();
+        }
+        catch (...)
+        {
+            release(owned, shift);
+            throw;
+        }
+    }
+
+    void replace_root(node* root, std::size_t shift) noexcept
+    {
+        release(root_, shift_);
+        root_ = root;
+        shift_ = shift;
+        //a root with one child is replaced by the child
+        while (shift_ > 0 && root_->count == 1)
+        {
+            auto child = retain(as_inner(root_)->children[0]);
+            release(root_, shift_);
+            root_ = child;
+            shift_ -= rrb_bits;
+        }
+    }
+
+    //moves the last leaf of the tree to the tail, which must be empty
+    void tail_from_tree()
+    {
+        const node* ptr = root_;
+        for (auto shift = shift_; shift > 0; shift -= rrb_bits)
+            ptr = as_inner(ptr)->children[ptr->count - 1];
+        auto last = retain(as_leaf(const_cast<node*>(ptr)));
+
+        if (root_->size == last->size)
+            replace_root(nullptr, 0);
+        else
+        {
+            node* rest;
+            try
+            {
+                rest = take_tree(root_, shift_, root_->size - last->size);
+            }
+            catch (...)
+            {
+                release(last, 0);
+                throw;
+            }
+            replace_root(rest, shift_);
+        }
+        tail_ = last;
+    }
+
+public:
+    void clear() noexcept
+    {
+        replace_root(nullptr, 0);
+        release(tail_, 0);
+        tail_ = nullptr;
+        size_ = 0;
+    }
+
+    //keeps the first n elements
+    void take(std::size_t n)
+    {
+        if (n >= size_)
+            return;
+        if (n == 0)
+            return clear();
+
+        auto offset = tail_offset();
+        if (n > offset)
+        {
+            auto kept = leaf_from(tail_, 0, n - offset);
+            release(tail_, 0);
+            tail_ = kept;
+        }
+        else
+        {
+            auto kept = take_tree(root_, shift_, n);
+            release(tail_, 0);
+            tail_ = nullptr;
+            replace_root(kept, shift_);
+            tail_from_tree();
+        }
+        size_ = n;
+    }
+
+    //removes the first n elements
+    void drop(std::size_t n)
+    {
+        if (n == 0)
+            return;
+        if (n >= size_)
+            return clear();
+
+        auto offset = tail_offset();
+        if (n >= offset)
+        {
+            auto kept = leaf_from(tail_, n - offset, tail_->count);
+            release(tail_, 0);
+            tail_ = kept;
+            replace_root(nullptr, 0);
+        }
+        else
+            replace_root(drop_tree(root_, shift_, n), shift_);
+        size_ -= n;
+    }
+
+    //appends the elements of rhs, sharing its nodes
+    void concat(const rrb_tree& rhs)
+    {
+        if (rhs.size_ == 0)
+            return;
+        if (size_ == 0)
+        {
+            *this = rhs;
+            return;
+        }
+        if (!rhs.root_)
+        {
+            for (std::uint32_t i = 0; i < rhs.tail_->count; i++)
+                emplace_back(rhs.tail_->elems[i]);
+            return;
+        }
+
+        //the tail goes into the tree, so both sides are trees
+        push_leaf(tail_);
+        release(tail_, 0);
+        tail_ = nullptr;
+
+        inner* top;
+        try
+        {
+            top = concat_trees(root_, shift_, rhs.root_, rhs.shift_);
+        }
+        catch (...)
+        {
+            tail_from_tree();
+            throw;
+        }
+        replace_root(top, std::max(shift_, rhs.shift_) + rrb_bits);
+        tail_ = retain(rhs.tail_);
+        size_ += rhs.size_;
+    }
+
+private:
+    //node at shift max(lshift, rshift) + rrb_bits holding the elements of lhs followed by those of rhs
+    inner* concat_trees(node* lhs, std::size_t lshift, node* rhs, std::size_t rshift)
+    {
+        if (lshift > rshift)
+        {
+            auto left = as_inner(lhs);
+            auto center = concat_trees(left->children[left->count - 1], lshift - rrb_bits, rhs, rshift);
+            return rebalance(left, center, nullptr, lshift);
+        }
+        if (lshift < rshift)
+        {
+            auto right = as_inner(rhs);
+            auto center = concat_trees(lhs, lshift, right->children[0], rshift - rrb_bits);
+            return rebalance(nullptr, center, right, rshift);
+        }
+        if (lshift == 0)
+        {
+            auto top = new_inner();
+            if (lhs->count + rhs->count <= rrb_branching)
+            {
+                leaf* merged;
+                try
+                {
+                    merged = leaf_from(as_leaf(lhs), 0, lhs->count);
+                    try
+                    {
+                        Ranges::uninitialized_copy(alloc_, as_leaf(rhs)->elems, as_leaf(rhs)->elems + rhs->count,
+                                                   merged->elems + merged->count);
+                    }
+                    catch (...)
+                    {
+                        free_leaf(merged);
+                        throw;
+                    }
+                }
+                catch (...)
+                {
+                    free_inner(top, rrb_bits);
+                    throw;
+                }
+                merged->count += rhs->count;
+                merged->size = merged->count;
+                top->children[0] = merged;
+                top->count = 1;
+            }
+            else
+            {
+                top->children[0] = retain(lhs);
+                top->children[1] = retain(rhs);
+                top->count = 2;
+            }
+            update_sizes(top, rrb_bits);
+            return top;
+        }
+
+        auto left = as_inner(lhs), right = as_inner(rhs);
+        auto center = concat_trees(left->children[left->count - 1], lshift - rrb_bits, right->children[0], rshift - rrb_bits);
+        return rebalance(left, center, right, lshift);
+    }
+
+    //merges the children of left but its last, of center and of right but its first, all at shift - rrb_bits,
+    //redistributing their slots so there are at most rrb_extras more nodes than needed;
+    //the result is at shift + rrb_bits. center is consumed, left and right are borrowed
+    inner* rebalance(inner* left, inner* center, inner* right, std::size_t shift)
+    {
+        constexpr std::size_t max_nodes = 2 * rrb_branching;
+        node* all[max_nodes + 2];
+        std::size_t counts[max_nodes + 2];
+        std::size_t n = 0, total = 0;
+        auto add = [&](node* ptr)
+        {
+            all[n] = ptr;
+            counts[n] = ptr->count;
+            total += ptr->count;
+            n++;
+        };
+        if (left)
+            for (std::uint32_t i = 0; i + 1 < left->count; i++)
+                add(left->children[i]);
+        for (std::uint32_t i = 0; i < center->count; i++)
+            add(center->children[i]);
+        if (right)
+            for (std::uint32_t i = 1; i < right->count; i++)
+                add(right->children[i]);
+
+        //concatenation plan: fold under-full nodes into their right neighbours until the node count is close to optimal
+        auto planned = n;
+        auto optimal = (total + rrb_branching - 1) / rrb_branching;
+        for (std::size_t i = 0; optimal + rrb_extras < planned;)
+        {
+            while (counts[i] > rrb_branching - rrb_extras / 2)
+                i++;
+            auto remaining = counts[i];
+            do
+            {
+                auto min_size = std::min(remaining + counts[i + 1], rrb_branching);
+                counts[i] = min_size;
+                remaining = remaining + counts[i + 1] - min_size;
+                i++;
+            } while (remaining > 0);
+            for (auto j = i; j + 1 < planned; j++)
+                counts[j] = counts[j + 1];
+            planned--;
+            i--;
+        }
+
+        auto child_shift = shift - rrb_bits;
+        //the parents are allocated first, so once the children are built nothing can fail
+        inner* halves[2] = {};
+        inner* top = nullptr;
+        node* built[max_nodes + 2];
+        std::size_t done = 0;
+        try
+        {
+            halves[0] = new_inner();
+            if (planned > rrb_branching)
+                halves[1] = new_inner();
+            top = new_inner();
+
+            std::size_t src = 0, offset = 0;
+            for (; done < planned; done++)
+            {
+                if (offset == 0 && all[src]->count == counts[done])
+                    built[done] = retain(all[src++]);
+                else
+                    built[done] = fill_node(all, src, offset, counts[done], child_shift);
+            }
+        }
+        catch (...)
+        {
+            for (std::size_t i = 0; i < done; i++)
+                release(built[i], child_shift);
+            for (auto half : halves)
+                release(half, shift);
+            release(top, shift + rrb_bits);
+            release(center, shift);
+            throw;
+        }
+
+        for (std::size_t i = 0; i < planned; i++)
+            halves[i / rrb_branching]->children[i % rrb_branching] = built[i];
+        for (auto half : halves)
+        {
+            if (!half)
+                continue;
+            half->count = static_cast<std::uint32_t>(std::min(planned, rrb_branching));
+            planned -= half->count;
+            update_sizes(half, shift);
+            top->children[top->count++] = half;
+        }
+        update_sizes(top, shift + rrb_bits);
+        release(center, shift);
+        return top;
+    }
+
+    //new node at shift with count slots taken from all[src] at offset onwards
+    node* fill_node(node* const* all, std::size_t& src, std::size_t& offset, std::size_t count, std::size_t shift)
+    {
+        if (shift == 0)
+        {
+            auto dst = new_leaf();
+            try
+            {
+                while (dst->count < count)
+                {
+                    auto from = as_leaf(all[src]);
+                    auto n = std::min<std::size_t>(count - dst->count, from->count - offset);
+                    Ranges::uninitialized_copy(alloc_, from->elems + offset, from->elems + offset + n, dst->elems + dst->count);
+                    dst->count += n;
+                    advance(all, src, offset, n);
+                }
+            }
+            catch (...)
+            {
+                free_leaf(dst);
+                throw;
+            }
+            dst->size = dst->count;
+            return dst;
+        }
+
+        auto dst = new_inner();
+        while (dst->count < count)
+        {
+            auto from = as_inner(all[src]);
+            auto n = std::min<std::size_t>(count - dst->count, from->count - offset);
+            for (std::size_t i = 0; i < n; i++)
+                dst->children[dst->count++] = retain(from->children[offset + i]);
+            advance(all, src, offset, n);
+        }
+        update_sizes(dst, shift);
+        return dst;
+    }
+
+    static void advance(node* const* all, std::size_t& src, std::size_t& offset, std::size_t n) noexcept
+    {
+        offset += n;
+        if (offset == all[src]->count)
+        {
+            src++;
+            offset = 0;
+        }
+    }
+};
+
+//random access iterator that remembers the leaf it is in
+template<typename Tree, typename T>
+class rrb_iterator
+{
+    const Tree* tree_ = nullptr;
+    std::size_t index_ = 0;
+    mutable const T* leaf_ = nullptr;
+    mutable std::size_t first_ = 0, last_ = 0;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = T;
+    using reference         = const T&;
+    using pointer           = const T*;
+
+    rrb_iterator() = default;
+    rrb_iterator(const Tree* tree, std::size_t index): tree_ {tree}, index_ {index} {}
+
+    reference operator*() const
+    {
+        if (index_ - first_ >= last_ - first_)
+        {
+            auto [ptr, start] = tree_->leaf_for(index_);
+            leaf_ = ptr->elems;
+            first_ = start;
+            last_ = start + ptr->count;
+        }
+        return leaf_[index_ - first_];
+    }
+    pointer operator->() const {return &**this;}
+    reference operator[](difference_type diff) const {return *(*this + diff);}
+
+    rrb_iterator& operator++()
+    {
+        index_++;
+        return *this;
+    }
+    rrb_iterator operator++(int)
+    {
+        rrb_iterator tmp (*this);
+        ++(*this);
+        return tmp;
+    }
+    rrb_iterator& operator--()
+    {
+        index_--;
+        return *this;
+    }
+    rrb_iterator operator--(int)
+    {
+        rrb_iterator tmp (*this);
+        --(*this);
+        return tmp;
+    }
+
+    rrb_iterator& operator+=(difference_type diff)
+    {
+        index_ += diff;
+        return *this;
+    }
+    rrb_iterator& operator-=(difference_type diff)
+    {
+        index_ -= diff;
+        return *this;
+    }
+
+    friend rrb_iterator operator+(rrb_iterator itr, difference_type diff) {return itr += diff;}
+    friend rrb_iterator operator+(difference_type diff, rrb_iterator itr) {return itr += diff;}
+    friend rrb_iterator operator-(rrb_iterator itr, difference_type diff) {return itr -= diff;}
+
+    difference_type operator-(const rrb_iterator& itr) const
+    {
+        return static_cast<difference_type>(index_) - static_cast<difference_type>(itr.index_);
+    }
+
+    bool operator==(const rrb_iterator& other) const {return index_ == other.index_;}
+    std::strong_ordering operator<=>(const rrb_iterator& other) const {return index_ <=> other.index_;}
+};
+
+} // namespace detail
+
+template<typename T, typename Allocator>
+class TransientVector;
+
+//immutable vector whose modifications return new versions that share all but O(log n) nodes with the old one.
+//A relaxed radix balanced tree of 32-way nodes plus a tail leaf: indexing, set, push_back, pop_back, take, drop
+//and concat are O(log32 n), appends mostly touch the tail only. Versions may be used from any threads.
+//For many modifications in a row use transient(), which edits the nodes it owns in place
+template<typename T, typename Allocator = std::allocator<T>>
+class PersistentVector final
+{
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = std::size_t;
+    using const_reference = const T&;
+    using transient_type  = TransientVector<T, Allocator>;
+
+private:
+    using tree = detail::rrb_tree<T, Allocator>;
+
+    tree tree_;
+
+    explicit PersistentVector(tree&& rep) noexcept: tree_ {std::move(rep)} {}
+
+    friend class TransientVector<T, Allocator>;
+
+public:
+    using iterator       = detail::rrb_iterator<tree, T>;
+    using const_iterator = iterator;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = reverse_iterator;
+
+    PersistentVector() = default;
+
+    explicit PersistentVector(const allocator_type& alloc): tree_ {alloc} {}
+
+    template<std::input_iterator InpIt>
+    PersistentVector(InpIt first, InpIt last, const allocator_type& alloc = allocator_type())
+    :tree_ {alloc}
+    {
+        for (; first != last; ++first)
+            tree_.emplace_back(*first);
+    }
+
+    PersistentVector(std::initializer_list<T> initlist, const allocator_type& alloc = allocator_type())
+    :PersistentVector(initlist.begin(), initlist.end(), alloc)
+    {}
+
+    //O(n)
+    template<typename A, typename G, typename S>
+    explicit PersistentVector(const Vector<T, A, G, S>& vec, const allocator_type& alloc = allocator_type())
+    :PersistentVector(vec.begin(), vec.end(), alloc)
+    {}
+
+    allocator_type get_allocator() const {return tree_.alloc_;}
+
+public:
+    size_type size() const noexcept {return tree_.size_;}
+    bool empty() const noexcept {return tree_.size_ == 0;}
+
+    const_reference operator[](size_type index) const noexcept {return tree_[index];}
+
+    const_reference at(size_type index) const
+    {
+        if (index >= size())
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return tree_[index];
+    }
+
+    const_reference front() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return tree_[0];
+    }
+
+    const_reference back() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return tree_[size() - 1];
+    }
+
+public:
+    //new versions; this one is left as it is
+
+    [[nodiscard]] PersistentVector set(size_type index, const value_type& val) const
+    {
+        if (index >= size())
+            throw std::out_of_range{"try to get acces to element out of array"};
+        auto next = tree_;
+        next.set(index, val);
+        return PersistentVector{std::move(next)};
+    }
+
+    [[nodiscard]] PersistentVector push_back(const value_type& val) const {return emplace_back(val);}
+    [[nodiscard]] PersistentVector push_back(value_type&& val) const {return emplace_back(std::move(val));}
+
+    template<typename... Args>
+    [[nodiscard]] PersistentVector emplace_back(Args&&... args) const
+    {
+        auto next = tree_;
+        next.emplace_back(std::forward<Args>(args)...);
+        return PersistentVector{std::move(next)};
+    }
+
+    [[nodiscard]] PersistentVector pop_back() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to pop element from empty vector"};
+        auto next = tree_;
+        next.pop_back();
+        return PersistentVector{std::move(next)};
+    }
+
+    //the first n elements
+    [[nodiscard]] PersistentVector take(size_type n) const
+    {
+        auto next = tree_;
+        next.take(n);
+        return PersistentVector{std::move(next)};
+    }
+
+    //all but the first n elements
+    [[nodiscard]] PersistentVector drop(size_type n) const
+    {
+        auto next = tree_;
+        next.drop(n);
+        return PersistentVector{std::move(next)};
+    }
+
+    //elements [first, last)
+    [[nodiscard]] PersistentVector slice(size_type first, size_type last) const
+    {
+        if (first > last || last > size())
+            throw std::out_of_range{"try to get slice out of array"};
+        auto next = tree_;
+        next.take(last);
+        next.drop(first);
+        return PersistentVector{std::move(next)};
+    }
+
+    //this followed by rhs
+    [[nodiscard]] PersistentVector concat(const PersistentVector& rhs) const
+    {
+        auto next = tree_;
+        next.concat(rhs.tree_);
+        return PersistentVector{std::move(next)};
+    }
+
+    //O(1), the transient shares the nodes until it modifies them
+    [[nodiscard]] transient_type transient() const {return transient_type{tree_};}
+
+    //O(n)
+    Vector<T, Allocator> to_vector() const
+    {
+        Vector<T, Allocator> vec (tree_.alloc_);
+        vec.reserve(size());
+        tree_.for_each_leaf([&vec](const T* elems, std::size_t count){vec.insert(vec.end(), elems, elems + count);});
+        return vec;
+    }
+
+    const_iterator begin() const {return const_iterator{&tree_, 0};}
+    const_iterator end()   const {return const_iterator{&tree_, size()};}
+
+    const_iterator cbegin() const {return begin();}
+    const_iterator cend()   const {return end();}
+
+    const_reverse_iterator rbegin() const {return const_reverse_iterator{end()};}
+    const_reverse_iterator rend()   const {return const_reverse_iterator{begin()};}
+}; // class PersistentVector
+
+//mutable builder over the representation of a PersistentVector: it modifies nodes that only it owns in place
+//and copies shared ones once, so a batch of n modifications costs about as much as n pushes to a Vector.
+//persistent() snapshots it in O(1); not thread safe, like a Vector
+template<typename T, typename Allocator = std::allocator<T>>
+class TransientVector final
+{
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = std::size_t;
+    using const_reference = const T&;
+
+private:
+    using tree = detail::rrb_tree<T, Allocator>;
+
+    tree tree_;
+
+    explicit TransientVector(const tree& rep): tree_ {rep} {}
+
+    friend class PersistentVector<T, Allocator>;
+
+public:
+    using iterator       = detail::rrb_iterator<tree, T>;
+    using const_iterator = iterator;
+
+    TransientVector() = default;
+    explicit TransientVector(const allocator_type& alloc): tree_ {alloc} {}
+
+    //O(n)
+    template<typename A, typename G, typename S>
+    explicit TransientVector(const Vector<T, A, G, S>& vec, const allocator_type& alloc = allocator_type())
+    :tree_ {alloc}
+    {
+        for (auto& elem : vec)
+            tree_.emplace_back(elem);
+    }
+
+    size_type size() const noexcept {return tree_.size_;}
+    bool empty() const noexcept {return tree_.size_ == 0;}
+
+    const_reference operator[](size_type index) const noexcept {return tree_[index];}
+
+    const_reference at(size_type index) const
+    {
+        if (index >= size())
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return tree_[index];
+    }
+
+    void set(size_type index, const value_type& val)
+    {
+        if (index >= size())
+            throw std::out_of_range{"try to get acces to element out of array"};
+        tree_.set(index, val);
+    }
+
+    void push_back(const value_type& val) {tree_.emplace_back(val);}
+    void push_back(value_type&& val) {tree_.emplace_back(std::move(val));}
+
+    template<typename... Args>
+    void emplace_back(Args&&... args) {tree_.emplace_back(std::forward<Args>(args)...);}
+
+    void pop_back()
+    {
+        if (empty())
+            throw std::underflow_error{"try to pop element from empty vector"};
+        tree_.pop_back();
+    }
+
+    void take(size_type n) {tree_.take(n);}
+    void drop(size_type n) {tree_.drop(n);}
+    void append(const PersistentVector<T, Allocator>& rhs) {tree_.concat(rhs.tree_);}
+    void clear() noexcept {tree_.clear();}
+
+    //O(1); later modifications of the transient copy the nodes they share with the snapshot
+    [[nodiscard]] PersistentVector<T, Allocator> persistent() const {return PersistentVector<T, Allocator>{tree{tree_}};}
+
+    Vector<T, Allocator> to_vector() const {return persistent().to_vector();}
+
+    const_iterator begin() const {return const_iterator{&tree_, 0};}
+    const_iterator end()   const {return const_iterator{&tree_, size()};}
+}; // class TransientVector
+
+} // namespace Container
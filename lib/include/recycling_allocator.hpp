@@ -0,0 +1,200 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <new>
+
+namespace Container
+{
+
+//per-thread cache of freed blocks, one free list per power of two size class. A freed block is kept for the next
+//allocation of its class on the freeing thread instead of going back to ::operator delete, so code that keeps
+//building and dropping vectors stops paying for the allocator on every step of the growth ladder.
+//The cached bytes are bounded by limit(), blocks over max_block_size are not cached at all.
+//Blocks may be freed on another thread than the one that allocated them
+class BufferPool
+{
+public:
+    static constexpr std::size_t min_class_bits = 6;
+    static constexpr std::size_t max_class_bits = 24;
+    static constexpr std::size_t min_block_size = std::size_t{1} << min_class_bits;
+    static constexpr std::size_t max_block_size = std::size_t{1} << max_class_bits;
+    static constexpr std::size_t default_limit  = std::size_t{32} << 20;
+
+    struct Stats
+    {
+        //allocations served from the cache and from ::operator new
+        std::size_t hits = 0, misses = 0;
+        //freed blocks kept in the cache, and given back because the cache was full or they were too big
+        std::size_t recycled = 0, released = 0;
+        std::size_t cached_bytes = 0;
+    };
+
+private:
+    static constexpr std::size_t class_count = max_class_bits - min_class_bits + 1;
+
+    //a free block holds the link to the next one
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    free_block* free_[class_count] = {};
+    std::size_t limit_ = default_limit;
+    Stats stats_;
+
+    BufferPool() = default;
+
+    static std::size_t class_of(std::size_t bytes) noexcept
+    {
+        return std::bit_width(std::max(bytes, min_block_size) - 1) - min_class_bits;
+    }
+
+    static std::size_t class_size(std::size_t cls) noexcept {return std::size_t{1} << (cls + min_class_bits);}
+
+    //set when the thread's pool is gone, blocks freed by later thread_local destructors skip it
+    static bool& destroyed() noexcept
+    {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+public:
+    BufferPool(const BufferPool&)            = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    ~BufferPool()
+    {
+        trim();
+        destroyed() = true;
+    }
+
+    //the pool of the calling thread, nullptr while the thread exits
+    static BufferPool* local() noexcept
+    {
+        if (destroyed())
+            return nullptr;
+        static thread_local BufferPool pool;
+        return &pool;
+    }
+
+    //bytes handed out for a request of bytes
+    static std::size_t block_size(std::size_t bytes) noexcept
+    {
+        return bytes > max_block_size ? bytes : class_size(class_of(bytes));
+    }
+
+    //a block of block_size(bytes) bytes
+    void* allocate(std::size_t bytes)
+    {
+        if (bytes > max_block_size)
+        {
+            stats_.misses++;
+            return ::operator new(bytes);
+        }
+
+        auto cls = class_of(bytes);
+        if (auto block = free_[cls])
+        {
+            free_[cls] = block->next;
+            stats_.hits++;
+            stats_.cached_bytes -= class_size(cls);
+            return block;
+        }
+        stats_.misses++;
+        return ::operator new(class_size(cls));
+    }
+
+    //bytes is anything that gives the same block_size as the allocation did
+    void deallocate(void* ptr, std::size_t bytes) noexcept
+    {
+        auto size = block_size(bytes);
+        if (bytes > max_block_size || stats_.cached_bytes + size > limit_)
+        {
+            stats_.released++;
+            ::operator delete(ptr);
+            return;
+        }
+
+        auto cls = class_of(bytes);
+        free_[cls] = ::new (ptr) free_block {free_[cls]};
+        stats_.recycled++;
+        stats_.cached_bytes += size;
+    }
+
+    //gives cached blocks back, the largest first, until at most keep_bytes stay cached
+    void trim(std::size_t keep_bytes = 0) noexcept
+    {
+        for (auto cls = class_count; cls-- > 0 && stats_.cached_bytes > keep_bytes;)
+            while (free_[cls] && stats_.cached_bytes > keep_bytes)
+            {
+                auto block = free_[cls];
+                free_[cls] = block->next;
+                stats_.cached_bytes -= class_size(cls);
+                ::operator delete(block);
+            }
+    }
+
+    std::size_t limit() const noexcept {return limit_;}
+
+    //bounds the cached bytes, trimming the cache if it holds more
+    void set_limit(std::size_t bytes) noexcept
+    {
+        limit_ = bytes;
+        trim(bytes);
+    }
+
+    Stats stats() const noexcept {return stats_;}
+
+    //zeroes the counters, cached_bytes stays as it is
+    void reset_stats() noexcept {stats_ = Stats{.cached_bytes = stats_.cached_bytes};}
+};
+
+//allocator whose blocks are recycled through the BufferPool of the calling thread. allocate_at_least reports
+//the whole size class, so Vector with Growth::UsableSize grows straight into it
+template<typename T>
+class RecyclingAllocator
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "RecyclingAllocator does not support over-aligned types");
+public:
+    using value_type = T;
+
+    struct allocation_result
+    {
+        T* ptr;
+        std::size_t count;
+    };
+
+    RecyclingAllocator() = default;
+
+    template<typename U>
+    RecyclingAllocator(const RecyclingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+        auto bytes = n * sizeof(T);
+        if (auto pool = BufferPool::local())
+            return static_cast<T*>(pool->allocate(bytes));
+        return static_cast<T*>(::operator new(BufferPool::block_size(bytes)));
+    }
+
+    allocation_result allocate_at_least(std::size_t n)
+    {
+        auto ptr = allocate(n);
+        return {ptr, BufferPool::block_size(n * sizeof(T)) / sizeof(T)};
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        if (auto pool = BufferPool::local())
+            pool->deallocate(ptr, n * sizeof(T));
+        else
+            ::operator delete(ptr);
+    }
+
+    friend bool operator==(const RecyclingAllocator&, const RecyclingAllocator&) noexcept {return true;}
+};
+
+} // namespace Container
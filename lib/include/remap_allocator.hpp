@@ -0,0 +1,83 @@
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "os_memory.hpp"
+
+namespace Container
+{
+
+//Allocator for trivially copyable elements that can grow blocks in place: realloc below MmapThreshold bytes
+//and mmap/mremap above it, so the kernel moves pages instead of copying them.
+//Vector uses reallocate() instead of allocate-relocate-deallocate whenever the allocator provides it.
+template<typename T, std::size_t MmapThreshold = std::size_t{1} << 24>
+class RemapAllocator
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "RemapAllocator does not support over-aligned types");
+public:
+    using value_type = T;
+    static constexpr std::size_t mmap_threshold = MmapThreshold;
+
+    template<typename U>
+    struct rebind {using other = RemapAllocator<U, MmapThreshold>;};
+
+    RemapAllocator() = default;
+
+    template<typename U>
+    RemapAllocator(const RemapAllocator<U, MmapThreshold>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+        auto bytes = n * sizeof(T);
+        auto ptr = is_mapped(bytes) ? os::map_anonymous(bytes) : std::malloc(bytes);
+        if (!ptr)
+            throw std::bad_alloc{};
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        auto bytes = n * sizeof(T);
+        if (is_mapped(bytes))
+            os::unmap(ptr, bytes);
+        else
+            std::free(ptr);
+    }
+
+    //throws std::bad_alloc and leaves the old block untouched on failure
+    T* reallocate(T* ptr, std::size_t old_n, std::size_t new_n)
+    {
+        if (new_n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+        auto old_bytes = old_n * sizeof(T), new_bytes = new_n * sizeof(T);
+
+        void* new_ptr = nullptr;
+        if (is_mapped(old_bytes) && is_mapped(new_bytes))
+            new_ptr = os::remap(ptr, old_bytes, new_bytes);
+        else if (!is_mapped(old_bytes) && !is_mapped(new_bytes))
+            new_ptr = std::realloc(ptr, new_bytes);
+        else
+        {
+            new_ptr = is_mapped(new_bytes) ? os::map_anonymous(new_bytes) : std::malloc(new_bytes);
+            if (new_ptr)
+            {
+                std::memcpy(new_ptr, ptr, std::min(old_bytes, new_bytes));
+                deallocate(ptr, old_n);
+            }
+        }
+
+        if (!new_ptr)
+            throw std::bad_alloc{};
+        return static_cast<T*>(new_ptr);
+    }
+
+    friend bool operator==(const RemapAllocator&, const RemapAllocator&) noexcept {return true;}
+
+private:
+    static bool is_mapped(std::size_t bytes) noexcept {return bytes >= MmapThreshold;}
+};
+
+} // namespace Container
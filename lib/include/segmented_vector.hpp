@@ -0,0 +1,324 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include "index_iterator.hpp"
+#include "vector.hpp"
+
+namespace Container
+{
+
+namespace detail
+{
+
+//about a page per block, at least 16 elements
+template<typename T>
+constexpr std::size_t segmented_block_size()
+{
+    return std::bit_floor(std::max<std::size_t>(16, 4096 / sizeof(T)));
+}
+
+} // namespace detail
+
+//Vector whose elements live in blocks of BlockSize behind a Vector of block pointers.
+//Growth allocates one more block and never relocates elements, so push_back has no size-proportional stalls
+//and references stay valid until the element is erased; only the pointer table is ever copied.
+//block(i) gives each block as a contiguous span for loops that should vectorize
+template<typename T, std::size_t BlockSize = detail::segmented_block_size<T>(), typename Allocator = std::allocator<T>>
+class SegmentedVector final
+{
+    static_assert(std::has_single_bit(BlockSize), "BlockSize must be a power of two");
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = std::size_t;
+
+    using iterator       = detail::index_iterator<SegmentedVector, T>;
+    using const_iterator = detail::index_iterator<SegmentedVector, const T>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type block_size = BlockSize;
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using block_table  = Vector<pointer, typename alloc_traits::template rebind_alloc<pointer>>;
+
+    static constexpr size_type block_shift = std::bit_width(BlockSize) - 1;
+    static constexpr size_type block_mask  = BlockSize - 1;
+
+    [[no_unique_address]] allocator_type alloc_;
+    block_table blocks_;
+    size_type used_ = 0;
+
+    void add_block()
+    {
+        auto block = alloc_traits::allocate(alloc_, BlockSize);
+        try
+        {
+            blocks_.push_back(block);
+        }
+        catch (...)
+        {
+            alloc_traits::deallocate(alloc_, block, BlockSize);
+            throw;
+        }
+    }
+
+    void release_blocks(size_type keep) noexcept
+    {
+        while (blocks_.size() > keep)
+        {
+            alloc_traits::deallocate(alloc_, blocks_.back(), BlockSize);
+            blocks_.pop_back();
+        }
+    }
+
+public:
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const allocator_type& alloc): alloc_ {alloc}, blocks_(alloc) {}
+
+    explicit SegmentedVector(size_type size, const allocator_type& alloc = allocator_type())
+    :SegmentedVector(alloc)
+    {
+        resize(size);
+    }
+
+    SegmentedVector(size_type size, const_reference val, const allocator_type& alloc = allocator_type())
+    :SegmentedVector(alloc)
+    {
+        resize(size, val);
+    }
+
+    template<std::input_iterator InpIt>
+    SegmentedVector(InpIt first, InpIt last, const allocator_type& alloc = allocator_type())
+    :SegmentedVector(alloc)
+    {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    SegmentedVector(std::initializer_list<T> initlist, const allocator_type& alloc = allocator_type())
+    :SegmentedVector(initlist.begin(), initlist.end(), alloc)
+    {}
+
+    SegmentedVector(const SegmentedVector& rhs)
+    :SegmentedVector(rhs.begin(), rhs.end(), alloc_traits::select_on_container_copy_construction(rhs.alloc_))
+    {}
+
+    SegmentedVector(SegmentedVector&& rhs) noexcept
+    :alloc_ {rhs.alloc_}, blocks_ {std::move(rhs.blocks_)}, used_ {std::exchange(rhs.used_, 0)}
+    {}
+
+    SegmentedVector& operator=(const SegmentedVector& rhs)
+    {
+        SegmentedVector cpy (rhs);
+        swap(cpy);
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept
+    {
+        SegmentedVector tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    ~SegmentedVector()
+    {
+        clear();
+        release_blocks(0);
+    }
+
+    //swaps allocators along with the blocks
+    void swap(SegmentedVector& rhs) noexcept
+    {
+        using std::swap;
+        swap(alloc_, rhs.alloc_);
+        blocks_.swap(rhs.blocks_);
+        swap(used_, rhs.used_);
+    }
+
+    friend void swap(SegmentedVector& lhs, SegmentedVector& rhs) noexcept {lhs.swap(rhs);}
+
+    allocator_type get_allocator() const {return alloc_;}
+
+public:
+    size_type size() const {return used_;}
+    size_type capacity() const {return blocks_.size() * BlockSize;}
+    bool empty() const {return used_ == 0;}
+
+    reference       operator[](size_type index)       noexcept {return blocks_[index >> block_shift][index & block_mask];}
+    const_reference operator[](size_type index) const noexcept {return blocks_[index >> block_shift][index & block_mask];}
+
+    reference at(size_type index)
+    {
+        if (index >= used_)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return (*this)[index];
+    }
+    const_reference at(size_type index) const
+    {
+        if (index >= used_)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return (*this)[index];
+    }
+
+    reference front()
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return (*this)[0];
+    }
+    const_reference front() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return (*this)[0];
+    }
+
+    reference back()
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return (*this)[used_ - 1];
+    }
+    const_reference back() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return (*this)[used_ - 1];
+    }
+
+    //number of blocks holding elements
+    size_type block_count() const {return (used_ + block_mask) >> block_shift;}
+
+    //elements of block i, the last one may be partially filled
+    std::span<T> block(size_type i)
+    {
+        return {blocks_[i], std::min(BlockSize, used_ - i * BlockSize)};
+    }
+    std::span<const T> block(size_type i) const
+    {
+        return {blocks_[i], std::min(BlockSize, used_ - i * BlockSize)};
+    }
+
+public:
+    void push_back(const value_type& val) {emplace_back(val);}
+    void push_back(value_type&& val) {emplace_back(std::move(val));}
+
+    //args may refer to elements of the vector itself, they stay in place
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if (used_ == capacity())
+            add_block();
+        auto ptr = &(*this)[used_];
+        alloc_traits::construct(alloc_, ptr, std::forward<Args>(args)...);
+        used_++;
+        return *ptr;
+    }
+
+    void pop_back()
+    {
+        if (empty())
+            throw std::underflow_error{"try to pop element from empty vector"};
+        used_--;
+        alloc_traits::destroy(alloc_, &(*this)[used_]);
+    }
+
+    void reserve(size_type newsz)
+    {
+        auto blocks = (newsz + block_mask) >> block_shift;
+        blocks_.reserve(blocks);
+        while (blocks_.size() < blocks)
+            add_block();
+    }
+
+private:
+    template<typename Initializer>
+    void resize_with(size_type newsz, Initializer initializer)
+    {
+        while (used_ > newsz)
+            pop_back();
+        if (used_ == newsz)
+            return;
+
+        reserve(newsz);
+        auto old_used = used_;
+        try
+        {
+            //block by block, so the std algorithms see contiguous ranges
+            while (used_ != newsz)
+            {
+                auto first = &(*this)[used_];
+                auto count = std::min(newsz - used_, BlockSize - (used_ & block_mask));
+                initializer(first, first + count);
+                used_ += count;
+            }
+        }
+        catch (...)
+        {
+            while (used_ > old_used)
+                pop_back();
+            throw;
+        }
+    }
+
+public:
+    void resize(size_type newsz)
+    {
+        resize_with(newsz, [this](pointer first, pointer last){Ranges::uninitialized_default_construct(alloc_, first, last);});
+    }
+
+    void resize(size_type newsz, const_reference value)
+    {
+        resize_with(newsz, [this, &value](pointer first, pointer last){Ranges::uninitialized_fill(alloc_, first, last, value);});
+    }
+
+    void clear()
+    {
+        for (size_type i = 0, count = block_count(); i < count; i++)
+        {
+            auto elems = block(i);
+            Ranges::destroy(alloc_, elems.data(), elems.data() + elems.size());
+        }
+        used_ = 0;
+    }
+
+    //frees the blocks past the last element
+    void shrink_to_fit()
+    {
+        release_blocks(block_count());
+        blocks_.shrink_to_fit();
+    }
+
+    iterator begin() {return iterator{this, 0};}
+    iterator end()   {return iterator{this, used_};}
+
+    const_iterator begin() const {return const_iterator{this, 0};}
+    const_iterator end()   const {return const_iterator{this, used_};}
+
+    const_iterator cbegin() const {return const_iterator{this, 0};}
+    const_iterator cend()   const {return const_iterator{this, used_};}
+
+    reverse_iterator rbegin() {return reverse_iterator{end()};}
+    reverse_iterator rend()   {return reverse_iterator{begin()};}
+
+    const_reverse_iterator rbegin() const {return const_reverse_iterator{end()};}
+    const_reverse_iterator rend()   const {return const_reverse_iterator{begin()};}
+
+    const_reverse_iterator crbegin() const {return const_reverse_iterator{cend()};}
+    const_reverse_iterator crend()   const {return const_reverse_iterator{cbegin()};}
+}; // class SegmentedVector
+
+} // namespace Container
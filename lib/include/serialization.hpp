@@ -0,0 +1,415 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "vector.hpp"
+
+//versioned binary format of a Vector on a file descriptor:
+//a fixed header (element size and alignment, count, payload size, checksum of the payload) and the payload.
+//Trivially copyable elements are the payload as is, written with one writev from data() and read
+//straight into the vector; other types go through a codec in fixed-size chunks.
+//Byte order is the host's, a stream from a host of the other byte order is rejected
+namespace Container::Serialization
+{
+
+inline constexpr std::size_t chunk_size = std::size_t{1} << 20;
+
+//64-bit checksum of a byte stream, four independent multiply-xor lanes over 8-byte words,
+//so it keeps up with the disk; the result does not depend on how the stream is split into updates
+class Checksum
+{
+    static constexpr std::uint64_t prime = 0x100000001b3;
+    static constexpr std::size_t block = 32;
+
+    std::uint64_t lanes_[4] = {0xcbf29ce484222325, 0x84222325cbf29ce4, 0x9e3779b97f4a7c15, 0x7f4a7c159e3779b9};
+    unsigned char tail_[block] {};
+    std::size_t tail_size_ = 0;
+    std::uint64_t total_ = 0;
+
+    void consume(const unsigned char* ptr) noexcept
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, ptr + 8 * i, 8);
+            lanes_[i] = (lanes_[i] ^ word) * prime;
+            lanes_[i] ^= lanes_[i] >> 29;
+        }
+    }
+
+public:
+    void update(const void* data, std::size_t bytes) noexcept
+    {
+        if (bytes == 0)
+            return;
+        auto ptr = static_cast<const unsigned char*>(data);
+        total_ += bytes;
+        if (tail_size_ != 0)
+        {
+            auto take = std::min(bytes, block - tail_size_);
+            std::memcpy(tail_ + tail_size_, ptr, take);
+            tail_size_ += take;
+            ptr += take;
+            bytes -= take;
+            if (tail_size_ < block)
+                return;
+            consume(tail_);
+            tail_size_ = 0;
+        }
+        for (; bytes >= block; ptr += block, bytes -= block)
+            consume(ptr);
+        std::memcpy(tail_, ptr, bytes);
+        tail_size_ = bytes;
+    }
+
+    std::uint64_t value() const noexcept
+    {
+        std::uint64_t hash = total_ * prime;
+        for (std::size_t i = 0; i < tail_size_; i++)
+            hash = (hash ^ tail_[i]) * prime;
+        for (auto lane : lanes_)
+            hash = (hash ^ lane) * prime;
+        return hash ^ (hash >> 32);
+    }
+};
+
+struct Header
+{
+    static constexpr std::uint64_t magic_value = 0x315453434556434c; //"LCVECST1"
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t encoded = 1; //payload was written by a codec
+
+    std::uint64_t magic = magic_value;
+    std::uint32_t version = current_version;
+    std::uint32_t flags = 0;
+    std::uint64_t element_size = 0;
+    std::uint64_t element_align = 0;
+    std::uint64_t count = 0;
+    std::uint64_t payload_bytes = 0;
+    std::uint64_t checksum = 0;
+};
+
+namespace detail
+{
+
+inline void write_all(int fd, iovec* iov, int iovcnt)
+{
+    while (iovcnt > 0)
+    {
+        auto written = ::writev(fd, iov, iovcnt);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error{errno, std::generic_category(), "can't write vector"};
+        }
+        auto done = static_cast<std::size_t>(written);
+        for (; iovcnt > 0 && done >= iov->iov_len; iov++, iovcnt--)
+            done -= iov->iov_len;
+        if (iovcnt > 0)
+        {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + done;
+            iov->iov_len -= done;
+        }
+    }
+}
+
+inline void read_all(int fd, void* data, std::size_t bytes)
+{
+    auto ptr = static_cast<char*>(data);
+    while (bytes != 0)
+    {
+        auto got = ::read(fd, ptr, bytes);
+        if (got < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error{errno, std::generic_category(), "can't read vector"};
+        }
+        if (got == 0)
+            throw std::runtime_error{"unexpected end of vector stream"};
+        ptr += got;
+        bytes -= static_cast<std::size_t>(got);
+    }
+}
+
+template<typename T>
+Header make_header(std::size_t count)
+{
+    Header hdr;
+    hdr.element_size = sizeof(T);
+    hdr.element_align = alignof(T);
+    hdr.count = count;
+    return hdr;
+}
+
+//bytes from the current offset to the end of a regular file, unknown for pipes and sockets
+inline constexpr std::uint64_t unknown_length = std::numeric_limits<std::uint64_t>::max();
+
+inline std::uint64_t bytes_left(int fd) noexcept
+{
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return unknown_length;
+    auto pos = ::lseek(fd, 0, SEEK_CUR);
+    if (pos < 0 || pos > st.st_size)
+        return unknown_length;
+    return static_cast<std::uint64_t>(st.st_size - pos);
+}
+
+template<typename T>
+Header read_header(int fd, std::uint32_t flags)
+{
+    Header hdr;
+    read_all(fd, &hdr, sizeof(hdr));
+    if (hdr.magic != Header::magic_value)
+        throw std::runtime_error{"not a vector stream or written with another byte order"};
+    if (hdr.version != Header::current_version)
+        throw std::runtime_error{"unsupported vector stream version"};
+    if (hdr.flags != flags)
+        throw std::runtime_error{(flags & Header::encoded) ? "vector stream was not written by a codec"
+                                                           : "vector stream was written by a codec"};
+    if (hdr.element_size != sizeof(T) || hdr.element_align != alignof(T))
+        throw std::runtime_error{"vector stream holds elements of another type"};
+    if (!(flags & Header::encoded) &&
+        (hdr.count > std::uint64_t(-1) / sizeof(T) || hdr.payload_bytes != hdr.count * sizeof(T)))
+        throw std::runtime_error{"corrupted vector stream header"};
+    auto left = bytes_left(fd);
+    if (left != unknown_length && hdr.payload_bytes > left)
+        throw std::runtime_error{"vector stream is shorter than its header says"};
+    return hdr;
+}
+
+//sink of a codec that only sizes and checksums the encoding
+class MeasuringSink
+{
+    Checksum checksum_;
+    std::uint64_t bytes_ = 0;
+
+public:
+    void write(const void* data, std::size_t bytes)
+    {
+        checksum_.update(data, bytes);
+        bytes_ += bytes;
+    }
+
+    std::uint64_t bytes() const noexcept {return bytes_;}
+    std::uint64_t checksum() const noexcept {return checksum_.value();}
+};
+
+//sink of a codec that sends the encoding to fd in chunk_size pieces
+class ChunkWriter
+{
+    int fd_;
+    Vector<std::byte> buffer_;
+
+public:
+    explicit ChunkWriter(int fd): fd_ {fd} {buffer_.reserve(chunk_size);}
+
+    void write(const void* data, std::size_t bytes)
+    {
+        auto ptr = static_cast<const std::byte*>(data);
+        while (bytes != 0)
+        {
+            auto take = std::min(bytes, chunk_size - buffer_.size());
+            buffer_.insert(buffer_.end(), ptr, ptr + take);
+            ptr += take;
+            bytes -= take;
+            if (buffer_.size() == chunk_size)
+                flush();
+        }
+    }
+
+    void flush()
+    {
+        iovec iov {buffer_.data(), buffer_.size()};
+        write_all(fd_, &iov, 1);
+        buffer_.clear();
+    }
+};
+
+//source of a codec: reads at most the payload from fd in chunk_size pieces
+class ChunkReader
+{
+    int fd_;
+    std::uint64_t remaining_;
+    Vector<std::byte> buffer_;
+    std::size_t pos_ = 0;
+    Checksum checksum_;
+
+    void refill()
+    {
+        auto bytes = static_cast<std::size_t>(std::min<std::uint64_t>(chunk_size, remaining_));
+        buffer_.resize_for_overwrite(bytes);
+        read_all(fd_, buffer_.data(), bytes);
+        checksum_.update(buffer_.data(), bytes);
+        remaining_ -= bytes;
+        pos_ = 0;
+    }
+
+public:
+    ChunkReader(int fd, std::uint64_t payload_bytes): fd_ {fd}, remaining_ {payload_bytes} {}
+
+    void read(void* data, std::size_t bytes)
+    {
+        if (bytes > this->remaining())
+            throw std::runtime_error{"codec reads past the end of the vector stream"};
+        auto ptr = static_cast<std::byte*>(data);
+        while (bytes != 0)
+        {
+            if (pos_ == buffer_.size())
+                refill();
+            auto take = std::min(bytes, buffer_.size() - pos_);
+            std::memcpy(ptr, buffer_.data() + pos_, take);
+            pos_ += take;
+            ptr += take;
+            bytes -= take;
+        }
+    }
+
+    //payload bytes the codec has not consumed yet
+    std::uint64_t remaining() const noexcept {return remaining_ + (buffer_.size() - pos_);}
+    std::uint64_t checksum() const noexcept {return checksum_.value();}
+};
+
+} // namespace detail
+
+//a codec turns one element into bytes and back:
+//  encode(const T&, Sink&), where sink.write(const void*, size_t) appends bytes
+//  decode(Source&) -> T, where source.read(void*, size_t) takes bytes and source.remaining() bounds them
+template<typename Codec, typename T>
+concept ElementCodec = requires (const Codec& codec, const T& val, detail::ChunkWriter& sink, detail::ChunkReader& source)
+{
+    codec.encode(val, sink);
+    {codec.decode(source)} -> std::convertible_to<T>;
+};
+
+//strings as a 64-bit length followed by the characters
+struct StringCodec
+{
+    template<typename Sink>
+    void encode(const std::string& str, Sink& sink) const
+    {
+        std::uint64_t length = str.size();
+        sink.write(&length, sizeof(length));
+        sink.write(str.data(), str.size());
+    }
+
+    template<typename Source>
+    std::string decode(Source& source) const
+    {
+        std::uint64_t length = 0;
+        source.read(&length, sizeof(length));
+        if (length > source.remaining())
+            throw std::runtime_error{"string is longer than the rest of the vector stream"};
+        std::string str (static_cast<std::size_t>(length), '\0');
+        source.read(str.data(), str.size());
+        return str;
+    }
+};
+
+//writes the elements with a single writev of the header and data()
+template<typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+requires std::is_trivially_copyable<T>::value
+void write(int fd, const Vector<T, Allocator, GrowthPolicy, Storage>& vec)
+{
+    auto hdr = detail::make_header<T>(vec.size());
+    hdr.payload_bytes = vec.size() * sizeof(T);
+    Checksum checksum;
+    checksum.update(vec.data(), hdr.payload_bytes);
+    hdr.checksum = checksum.value();
+
+    iovec iov[2] = {{&hdr, sizeof(hdr)}, {const_cast<T*>(vec.data()), hdr.payload_bytes}};
+    detail::write_all(fd, iov, 2);
+}
+
+//encodes twice, first to size and checksum the payload for the header, then to write it,
+//so only one chunk is ever buffered
+template<typename T, typename Allocator, typename GrowthPolicy, typename Storage, ElementCodec<T> Codec>
+void write(int fd, const Vector<T, Allocator, GrowthPolicy, Storage>& vec, const Codec& codec)
+{
+    detail::MeasuringSink measure;
+    for (auto& elem : vec)
+        codec.encode(elem, measure);
+
+    auto hdr = detail::make_header<T>(vec.size());
+    hdr.flags = Header::encoded;
+    hdr.payload_bytes = measure.bytes();
+    hdr.checksum = measure.checksum();
+
+    detail::ChunkWriter writer {fd};
+    writer.write(&hdr, sizeof(hdr));
+    for (auto& elem : vec)
+        codec.encode(elem, writer);
+    writer.flush();
+}
+
+//replaces the contents of vec; the data is read straight into the vector chunk by chunk,
+//vec is left empty if the stream is broken.
+//The count is checked against the length of a file before anything is allocated; a pipe can't tell it,
+//so the vector grows one chunk at a time and a corrupted count fails at the end of the data that came
+template<typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+requires std::is_trivially_copyable<T>::value
+void read(int fd, Vector<T, Allocator, GrowthPolicy, Storage>& vec)
+{
+    auto hdr = detail::read_header<T>(fd, 0);
+    vec.clear();
+    auto count = static_cast<std::size_t>(hdr.count);
+    if (detail::bytes_left(fd) != detail::unknown_length)
+        vec.reserve(count);
+
+    Checksum checksum;
+    auto per_chunk = std::max<std::size_t>(1, chunk_size / sizeof(T));
+    try
+    {
+        for (std::size_t done = 0; done != count;)
+        {
+            auto n = std::min(per_chunk, count - done);
+            if (done + n > vec.capacity())
+                vec.reserve(std::min(count, std::max(done + n, 2 * vec.capacity())));
+            vec.resize_for_overwrite(done + n);
+            auto ptr = reinterpret_cast<char*>(vec.data() + done);
+            detail::read_all(fd, ptr, n * sizeof(T));
+            checksum.update(ptr, n * sizeof(T));
+            done += n;
+        }
+        if (checksum.value() != hdr.checksum)
+            throw std::runtime_error{"vector stream checksum mismatch"};
+    }
+    catch (...)
+    {
+        vec.clear();
+        throw;
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy, typename Storage, ElementCodec<T> Codec>
+void read(int fd, Vector<T, Allocator, GrowthPolicy, Storage>& vec, const Codec& codec)
+{
+    auto hdr = detail::read_header<T>(fd, Header::encoded);
+    vec.clear();
+    detail::ChunkReader reader {fd, hdr.payload_bytes};
+    try
+    {
+        for (std::uint64_t i = 0; i != hdr.count; i++)
+            vec.emplace_back(codec.decode(reader));
+        if (reader.remaining() != 0 || reader.checksum() != hdr.checksum)
+            throw std::runtime_error{"vector stream checksum mismatch"};
+    }
+    catch (...)
+    {
+        vec.clear();
+        throw;
+    }
+}
+
+} // namespace Container::Serialization
@@ -0,0 +1,252 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+
+namespace Container
+{
+
+//copy-on-write handle to a Vector: copies share one buffer through the atomic reference count of a shared_ptr
+//and cost O(1); the first modification through a handle that is not the only owner copies the elements
+//into a buffer of its own (detaches). Reading is only possible through const members, so reads never detach.
+//Handles on different threads may share a buffer freely, a single handle follows the usual container rules
+template<typename T, typename Allocator = std::allocator<T>>
+class SharedVector final
+{
+public:
+    using vector_type     = Vector<T, Allocator>;
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = std::size_t;
+    using const_reference = const T&;
+    using const_pointer   = const T*;
+    using const_iterator  = typename vector_type::const_iterator;
+    using const_reverse_iterator = typename vector_type::const_reverse_iterator;
+
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using block_allocator = typename alloc_traits::template rebind_alloc<vector_type>;
+
+    //moved-from handles share one empty buffer only when any allocator can stand for the source's
+    static constexpr bool shares_empty_buffer =
+        alloc_traits::is_always_equal::value && std::is_default_constructible<Allocator>::value;
+
+    //never null, so readers need no checks
+    std::shared_ptr<vector_type> buf_;
+
+    static std::shared_ptr<vector_type> make_buffer(vector_type&& vec)
+    {
+        return std::allocate_shared<vector_type>(block_allocator(vec.get_allocator()), std::move(vec));
+    }
+
+    explicit SharedVector(std::shared_ptr<vector_type> buf) noexcept: buf_ {std::move(buf)} {}
+
+    template<typename U, typename A>
+    friend class AtomicSharedVector;
+
+public:
+    SharedVector(): SharedVector(vector_type{}) {}
+
+    //takes over the elements of vec
+    explicit SharedVector(vector_type vec): buf_ {make_buffer(std::move(vec))} {}
+
+    SharedVector(std::initializer_list<T> initlist, const allocator_type& alloc = allocator_type())
+    :SharedVector(vector_type(initlist, alloc))
+    {}
+
+    SharedVector(const SharedVector&) = default;
+    SharedVector& operator=(const SharedVector&) = default;
+
+    //leaves rhs empty rather than null
+    SharedVector(SharedVector&& rhs) noexcept(shares_empty_buffer)
+    :buf_ {std::exchange(rhs.buf_, empty_buffer(rhs.get_allocator()))}
+    {}
+    SharedVector& operator=(SharedVector&& rhs) noexcept(shares_empty_buffer)
+    {
+        buf_ = std::exchange(rhs.buf_, empty_buffer(rhs.get_allocator()));
+        return *this;
+    }
+
+    ~SharedVector() = default;
+
+    void swap(SharedVector& rhs) noexcept {buf_.swap(rhs.buf_);}
+    friend void swap(SharedVector& lhs, SharedVector& rhs) noexcept {lhs.swap(rhs);}
+
+    allocator_type get_allocator() const {return buf_->get_allocator();}
+
+private:
+    //one shared empty buffer for moved-from handles, so a move never allocates;
+    //with stateful allocators each moved-from handle gets an empty buffer with the allocator of the source
+    static std::shared_ptr<vector_type> empty_buffer(const allocator_type& alloc) noexcept(shares_empty_buffer)
+    {
+        if constexpr (shares_empty_buffer)
+        {
+            static const std::shared_ptr<vector_type> empty = make_buffer(vector_type{});
+            return empty;
+        }
+        else
+            return make_buffer(vector_type(alloc));
+    }
+
+public:
+    //the shared elements; valid while this handle keeps the buffer
+    const vector_type& get() const noexcept {return *buf_;}
+
+    //number of handles sharing the buffer, an estimate when other threads copy or drop them
+    long use_count() const noexcept {return buf_.use_count();}
+    bool unique() const noexcept {return use_count() == 1;}
+
+private:
+    //makes the buffer exclusive to this handle and gives it for modification; references into the shared
+    //buffer stay valid for the other owners. The reference is private: a later copy of the handle
+    //would share the buffer it modifies
+    vector_type& mutate()
+    {
+        if (buf_.use_count() == 1)
+            //the other owners dropped the buffer with release decrements, their reads happen before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+        else
+            buf_ = make_buffer(vector_type(*buf_));
+        return *buf_;
+    }
+
+    //detaches keeping only the first count elements, for modifications that shrink a shared buffer
+    void detach_prefix(size_type count)
+    {
+        auto alloc = alloc_traits::select_on_container_copy_construction(get_allocator());
+        buf_ = make_buffer(vector_type(begin(), begin() + count, alloc));
+    }
+
+public:
+    size_type size() const noexcept {return buf_->size();}
+    size_type capacity() const noexcept {return buf_->capacity();}
+    bool empty() const noexcept {return buf_->empty();}
+    const_pointer data() const noexcept {return buf_->data();}
+
+    const_reference operator[](size_type index) const noexcept {return (*buf_)[index];}
+    const_reference at(size_type index) const {return buf_->at(index);}
+    const_reference front() const {return buf_->front();}
+    const_reference back() const {return buf_->back();}
+
+    std::span<const T> subspan(size_type offset, size_type count = std::dynamic_extent) const
+    {
+        return std::as_const(*buf_).subspan(offset, count);
+    }
+
+    const_iterator begin() const noexcept {return buf_->cbegin();}
+    const_iterator end()   const noexcept {return buf_->cend();}
+
+    const_iterator cbegin() const noexcept {return buf_->cbegin();}
+    const_iterator cend()   const noexcept {return buf_->cend();}
+
+    const_reverse_iterator rbegin() const noexcept {return buf_->crbegin();}
+    const_reverse_iterator rend()   const noexcept {return buf_->crend();}
+
+    //fn(vec) modifies the detached elements with arguments that may refer to the shared ones,
+    //which are kept alive until it returns. vec must not be kept past fn
+    template<typename Fn>
+    void modify(Fn fn)
+    {
+        std::shared_ptr<vector_type> shared = unique() ? nullptr : buf_;
+        fn(mutate());
+    }
+
+    //modifications detach first, those that shrink a shared buffer copy only the elements they keep
+    void set(size_type index, const value_type& val) {modify([&](vector_type& vec){vec.at(index) = val;});}
+    void push_back(const value_type& val) {emplace_back(val);}
+    void push_back(value_type&& val) {emplace_back(std::move(val));}
+
+    template<typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        modify([&](vector_type& vec){vec.emplace_back(std::forward<Args>(args)...);});
+    }
+
+    void pop_back()
+    {
+        if (unique() || empty())
+            mutate().pop_back();
+        else
+            detach_prefix(size() - 1);
+    }
+
+    void resize(size_type newsz)
+    {
+        if (newsz < size() && !unique())
+            detach_prefix(newsz);
+        else
+            mutate().resize(newsz);
+    }
+
+    void resize(size_type newsz, const value_type& val)
+    {
+        if (newsz < size() && !unique())
+            detach_prefix(newsz);
+        else
+            modify([&](vector_type& vec){vec.resize(newsz, val);});
+    }
+    void reserve(size_type newsz) {mutate().reserve(newsz);}
+
+    //drops this handle's reference instead of destroying elements other owners may still read
+    void clear()
+    {
+        if (unique())
+            mutate().clear();
+        else
+            buf_ = make_buffer(vector_type(get_allocator()));
+    }
+}; // class SharedVector
+
+//RCU-style slot holding the current version of a SharedVector: readers load() a snapshot without waiting for
+//writers, a writer prepares the next version off to the side and publish()es it with one pointer swap.
+//Readers that still hold the previous version keep it alive, it is freed when the last of them drops it.
+//Loads and publishes hold an internal spinlock only for the pointer copy, never while elements are copied
+template<typename T, typename Allocator = std::allocator<T>>
+class AtomicSharedVector final
+{
+public:
+    using value_type = SharedVector<T, Allocator>;
+
+private:
+    using vector_type = typename value_type::vector_type;
+
+    std::atomic<std::shared_ptr<vector_type>> current_;
+
+public:
+    AtomicSharedVector(): AtomicSharedVector(value_type{}) {}
+    explicit AtomicSharedVector(value_type initial): current_ {std::move(initial.buf_)} {}
+
+    AtomicSharedVector(const AtomicSharedVector&)            = delete;
+    AtomicSharedVector& operator=(const AtomicSharedVector&) = delete;
+
+    //thread safe; the version that is current now
+    value_type load() const {return value_type{current_.load(std::memory_order_acquire)};}
+
+    //thread safe; makes next the current version
+    void publish(value_type next) {current_.store(std::move(next.buf_), std::memory_order_release);}
+
+    //thread safe; publishes fn applied to a private copy of the current version, retrying if another writer
+    //published in between, so concurrent updates are not lost. fn may run more than once
+    template<typename Fn>
+    void update(Fn fn)
+    {
+        auto expected = current_.load(std::memory_order_acquire);
+        for (;;)
+        {
+            vector_type next (*expected);
+            fn(next);
+            auto desired = value_type::make_buffer(std::move(next));
+            if (current_.compare_exchange_weak(expected, std::move(desired), std::memory_order_acq_rel,
+                                               std::memory_order_acquire))
+                return;
+        }
+    }
+}; // class AtomicSharedVector
+
+} // namespace Container
@@ -0,0 +1,147 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include "vector.hpp"
+
+namespace Container
+{
+
+namespace detail
+{
+
+//keeps up to N elements in the object itself and spills to the allocator on overflow;
+//a heap block is always bigger than N, so data_ points either to storage_ or to the heap
+template<typename T, std::size_t N, typename Allocator>
+class SmallVectorBuf: public VectorBuf<T, Allocator>
+{
+    using base           = VectorBuf<T, Allocator>;
+    using pointer        = T*;
+    using size_type      = std::size_t;
+    using allocator_type = Allocator;
+
+    static_assert(N > 0, "SmallVector without inline capacity is a Vector");
+protected:
+    using base::alloc_;
+    using base::size_;
+    using base::used_;
+    using base::data_;
+    using typename base::allocation;
+
+    static constexpr size_type inline_capacity = N;
+    static constexpr bool can_reallocate = false;
+    static constexpr bool nothrow_swap = std::is_nothrow_move_constructible<T>::value && std::is_nothrow_swappable<T>::value;
+
+private:
+    alignas(T) std::byte storage_[sizeof(T) * N];
+
+    pointer inline_data() noexcept {return reinterpret_cast<pointer>(storage_);}
+
+protected:
+    bool is_inline() const noexcept {return data_ == reinterpret_cast<const T*>(storage_);}
+
+    SmallVectorBuf(size_type size = 0, const allocator_type& alloc = allocator_type()): base(0, alloc)
+    {
+        if (size > N)
+        {
+            auto [ptr, count] = base::allocate_at_least(size);
+            data_ = ptr;
+            size_ = count;
+        }
+        else
+        {
+            data_ = inline_data();
+            size_ = N;
+        }
+    }
+
+    SmallVectorBuf(SmallVectorBuf&& rhs) noexcept(nothrow_swap): base(0, rhs.alloc_)
+    {
+        data_ = inline_data();
+        size_ = N;
+        if constexpr (nothrow_swap)
+            swap_data(rhs);
+        else
+        {
+            try
+            {
+                swap_data(rhs);
+            }
+            catch (...)
+            {
+                data_ = nullptr;
+                size_ = 0;
+                throw;
+            }
+        }
+    }
+
+    allocation allocate_at_least(size_type n, bool claim_slack = false)
+    {
+        if (n <= N && !is_inline())
+            return {inline_data(), N};
+        return base::allocate_at_least(n, claim_slack);
+    }
+
+    void deallocate(pointer ptr, size_type n) noexcept
+    {
+        if (ptr != inline_data())
+            base::deallocate(ptr, n);
+    }
+
+    void release_unused() noexcept
+    {
+        if (!is_inline())
+            base::release_unused();
+    }
+
+    //inline elements are relocated between the objects, heap blocks are swapped by pointer
+    void swap_data(SmallVectorBuf& rhs) noexcept(nothrow_swap)
+    {
+        if (!is_inline() && !rhs.is_inline())
+            return base::swap_data(rhs);
+
+        if (is_inline() && rhs.is_inline())
+        {
+            auto& shorter = (used_ <= rhs.used_) ? *this : rhs;
+            auto& longer  = (used_ <= rhs.used_) ? rhs : *this;
+            std::swap_ranges(shorter.data_, shorter.data_ + shorter.used_, longer.data_);
+            Ranges::uninitialized_relocate(alloc_, longer.data_ + shorter.used_, longer.data_ + longer.used_,
+                                           shorter.data_ + shorter.used_);
+            std::swap(used_, rhs.used_);
+            return;
+        }
+
+        auto& local  = is_inline() ? *this : rhs;
+        auto& remote = is_inline() ? rhs : *this;
+        Ranges::uninitialized_relocate(alloc_, local.data_, local.data_ + local.used_, remote.inline_data());
+        local.data_  = remote.data_;
+        local.size_  = remote.size_;
+        remote.data_ = remote.inline_data();
+        remote.size_ = N;
+        std::swap(local.used_, remote.used_);
+    }
+
+    void swap(SmallVectorBuf& rhs) noexcept(nothrow_swap)
+    {
+        using std::swap;
+        swap_data(rhs);
+        swap(alloc_, rhs.alloc_);
+    }
+
+    ~SmallVectorBuf()
+    {
+        if (is_inline())
+        {
+            Ranges::destroy(alloc_, data_, data_ + used_);
+            data_ = nullptr;
+            size_ = used_ = 0;
+        }
+    }
+};
+
+} // namespace detail
+
+template<typename T, std::size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = Growth::Doubling>
+using SmallVector = Vector<T, Allocator, GrowthPolicy, detail::SmallVectorBuf<T, N, Allocator>>;
+
+} // namespace Container
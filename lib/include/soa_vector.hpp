@@ -0,0 +1,579 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "growth_policy.hpp"
+#include "index_iterator.hpp"
+#include "my_ranges.hpp"
+
+namespace Container
+{
+
+namespace detail
+{
+
+//row of a SoAVector: references to one element of every column, Fields are const for const rows.
+//Assignment writes through to the elements, a row never rebinds; structured bindings give the references
+template<typename... Fields>
+class soa_row
+{
+    std::tuple<Fields&...> refs_;
+
+public:
+    using value_type = std::tuple<std::remove_const_t<Fields>...>;
+
+    explicit soa_row(Fields&... fields): refs_ {fields...} {}
+
+    soa_row(const soa_row&) = default;
+
+    template<std::size_t I>
+    auto& get() const {return std::get<I>(refs_);}
+
+    operator value_type() const {return value_type{refs_};}
+
+    soa_row& operator=(const soa_row& rhs)
+    {
+        refs_ = rhs.refs_;
+        return *this;
+    }
+    soa_row& operator=(const value_type& val)
+    {
+        refs_ = val;
+        return *this;
+    }
+    soa_row& operator=(value_type&& val)
+    {
+        refs_ = std::move(val);
+        return *this;
+    }
+
+    //swaps the elements, rows are prvalues returned by the iterators
+    friend void swap(soa_row lhs, soa_row rhs) requires (!std::is_const<Fields>::value && ...)
+    {
+        using std::swap;
+        [&]<std::size_t... I>(std::index_sequence<I...>){(swap(std::get<I>(lhs.refs_), std::get<I>(rhs.refs_)), ...);}
+        (std::index_sequence_for<Fields...>{});
+    }
+
+    friend bool operator==(const soa_row& lhs, const value_type& rhs) {return lhs.refs_ == rhs;}
+
+    template<typename... Others>
+    friend bool operator==(const soa_row& lhs, const soa_row<Others...>& rhs) {return lhs.refs_ == rhs.refs_;}
+
+    template<typename... Others>
+    friend class soa_row;
+};
+
+} // namespace detail
+
+//Vector of rows of Ts... stored column-wise: each field lives in its own contiguous array, so a loop over one
+//field only touches that field's cache lines, and column<I>() gives it as a span for loops that should vectorize.
+//All columns share one size and capacity and are carved out of a single allocation, each column starting on
+//a column_alignment boundary; growing reallocates them together.
+//Reallocation gives the strong guarantee as long as every column is nothrow movable or copyable:
+//columns that may throw are copied first, so the old block is untouched until nothing else can throw.
+//Rows are accessed through proxy references, like std::vector<bool>
+template<typename Allocator, typename... Ts>
+class BasicSoAVector final
+{
+    static_assert(sizeof...(Ts) > 0, "SoAVector needs at least one column");
+public:
+    using value_type      = std::tuple<Ts...>;
+    using allocator_type  = Allocator;
+    using reference       = detail::soa_row<Ts...>;
+    using const_reference = detail::soa_row<const Ts...>;
+    using size_type       = std::size_t;
+
+    using iterator       = detail::index_iterator<BasicSoAVector, value_type, reference>;
+    using const_iterator = detail::index_iterator<BasicSoAVector, const value_type, const_reference>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    template<size_type I>
+    using column_type = std::tuple_element_t<I, value_type>;
+
+    static constexpr size_type columns = sizeof...(Ts);
+    //a cache line at least, so columns do not share lines and SIMD loads of a column start aligned
+    static constexpr size_type column_alignment = std::max({size_type{64}, alignof(Ts)...});
+
+private:
+    struct alignas(column_alignment) chunk
+    {
+        std::byte bytes[column_alignment];
+    };
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using chunk_allocator = typename alloc_traits::template rebind_alloc<chunk>;
+    using chunk_traits    = std::allocator_traits<chunk_allocator>;
+    using column_pointers = std::tuple<Ts*...>;
+
+    template<size_type I>
+    using column_allocator = typename alloc_traits::template rebind_alloc<column_type<I>>;
+
+    static constexpr size_type row_bytes = (sizeof(Ts) + ...);
+
+    //moving the column may throw, so it is copied and the source destroyed only once every column is in place
+    template<size_type I>
+    static constexpr bool relocation_may_throw = !Ranges::relocates_bitwise_v<column_allocator<I>, column_type<I>> &&
+                                                 !std::is_nothrow_move_constructible<column_type<I>>::value;
+
+    [[no_unique_address]] allocator_type alloc_;
+    chunk* block_ = nullptr;
+    column_pointers data_ {};
+    size_type size_ = 0, used_ = 0;
+
+    template<typename Fn>
+    static void for_each_column(Fn&& fn)
+    {
+        [&]<size_type... I>(std::index_sequence<I...>){(fn.template operator()<I>(), ...);}(std::index_sequence_for<Ts...>{});
+    }
+
+    template<size_type I>
+    column_allocator<I> column_alloc() const {return column_allocator<I>(alloc_);}
+
+    static constexpr size_type column_bytes(size_type capacity, size_type elem_size)
+    {
+        return (capacity * elem_size + column_alignment - 1) / column_alignment * column_alignment;
+    }
+
+    static constexpr size_type chunks_for(size_type capacity)
+    {
+        return (column_bytes(capacity, sizeof(Ts)) + ...) / column_alignment;
+    }
+
+    static column_pointers carve(chunk* block, size_type capacity)
+    {
+        auto bytes = reinterpret_cast<std::byte*>(block);
+        auto take = [&bytes, capacity]<typename T>(std::type_identity<T>)
+        {
+            auto column = reinterpret_cast<T*>(bytes);
+            bytes += column_bytes(capacity, sizeof(T));
+            return column;
+        };
+        //braced initialization evaluates left to right
+        return column_pointers{take(std::type_identity<Ts>{})...};
+    }
+
+    chunk* allocate(size_type capacity)
+    {
+        if (capacity > max_size())
+            throw std::length_error{"SoAVector capacity exceeds max_size()"};
+        chunk_allocator alloc {alloc_};
+        return chunk_traits::allocate(alloc, chunks_for(capacity));
+    }
+
+    void deallocate(chunk* block, size_type capacity) noexcept
+    {
+        if (!block)
+            return;
+        chunk_allocator alloc {alloc_};
+        chunk_traits::deallocate(alloc, block, chunks_for(capacity));
+    }
+
+    //destroys rows [first, last) of the first count columns
+    void destroy_columns(const column_pointers& data, size_type first, size_type last, size_type count = columns) noexcept
+    {
+        for_each_column([&]<size_type I>()
+        {
+            if (I >= count)
+                return;
+            auto alloc = column_alloc<I>();
+            Ranges::destroy(alloc, std::get<I>(data) + first, std::get<I>(data) + last);
+        });
+    }
+
+    //fill(alloc, first, last, column) for every column over rows [used_, newsz), rolling back on exception
+    template<typename Fill>
+    void construct_tail(size_type newsz, Fill fill)
+    {
+        size_type built = 0;
+        try
+        {
+            for_each_column([&]<size_type I>()
+            {
+                auto alloc = column_alloc<I>();
+                fill(alloc, std::get<I>(data_) + used_, std::get<I>(data_) + newsz, std::integral_constant<size_type, I>{});
+                built++;
+            });
+        }
+        catch (...)
+        {
+            destroy_columns(data_, used_, newsz, built);
+            throw;
+        }
+        used_ = newsz;
+    }
+
+    //constructs row index of data from one argument per column
+    template<typename... Args>
+    void construct_row(const column_pointers& data, size_type index, Args&&... args)
+    {
+        size_type built = 0;
+        try
+        {
+            [&]<size_type... I>(std::index_sequence<I...>)
+            {
+                ((construct_field<I>(std::get<I>(data) + index, std::forward<Args>(args)), built++), ...);
+            }(std::index_sequence_for<Ts...>{});
+        }
+        catch (...)
+        {
+            destroy_columns(data, index, index + 1, built);
+            throw;
+        }
+    }
+
+    template<size_type I, typename Arg>
+    void construct_field(column_type<I>* ptr, Arg&& arg)
+    {
+        auto alloc = column_alloc<I>();
+        std::allocator_traits<column_allocator<I>>::construct(alloc, ptr, std::forward<Arg>(arg));
+    }
+
+    //moves the rows to data, which must not throw once a column has been moved
+    void relocate_columns(const column_pointers& data)
+    {
+        bool built[columns] = {};
+        try
+        {
+            for_each_column([&]<size_type I>()
+            {
+                if constexpr (relocation_may_throw<I>)
+                {
+                    auto alloc = column_alloc<I>();
+                    Ranges::strong_guarantee_uninitialized_move_or_copy(alloc, std::get<I>(data_), std::get<I>(data_) + used_,
+                                                                        std::get<I>(data));
+                    built[I] = true;
+                }
+            });
+        }
+        catch (...)
+        {
+            for_each_column([&]<size_type I>()
+            {
+                auto alloc = column_alloc<I>();
+                if (built[I])
+                    Ranges::destroy(alloc, std::get<I>(data), std::get<I>(data) + used_);
+            });
+            throw;
+        }
+
+        for_each_column([&]<size_type I>()
+        {
+            auto alloc = column_alloc<I>();
+            if constexpr (relocation_may_throw<I>)
+                Ranges::destroy(alloc, std::get<I>(data_), std::get<I>(data_) + used_);
+            else
+                Ranges::uninitialized_relocate(alloc, std::get<I>(data_), std::get<I>(data_) + used_, std::get<I>(data));
+        });
+    }
+
+    //moves every row to a block of newcap rows; with row arguments (one per column) the row at used_ is built
+    //in the new block first, so the arguments may still refer to the old rows
+    template<typename... Row>
+    void reallocate(size_type newcap, Row&&... row)
+    {
+        auto block = allocate(newcap);
+        auto data = carve(block, newcap);
+        try
+        {
+            if constexpr (sizeof...(Row) != 0)
+            {
+                construct_row(data, used_, std::forward<Row>(row)...);
+                try
+                {
+                    relocate_columns(data);
+                }
+                catch (...)
+                {
+                    destroy_columns(data, used_, used_ + 1);
+                    throw;
+                }
+            }
+            else
+                relocate_columns(data);
+        }
+        catch (...)
+        {
+            deallocate(block, newcap);
+            throw;
+        }
+        deallocate(block_, size_);
+        block_ = block;
+        data_ = data;
+        size_ = newcap;
+    }
+
+    size_type next_capacity(size_type required) const
+    {
+        return std::max(Growth::Doubling::next_capacity(size_, required, row_bytes), required);
+    }
+
+public:
+    BasicSoAVector() = default;
+
+    explicit BasicSoAVector(const allocator_type& alloc) noexcept: alloc_ {alloc} {}
+
+    explicit BasicSoAVector(size_type size, const allocator_type& alloc = allocator_type())
+    :BasicSoAVector(alloc)
+    {
+        resize(size);
+    }
+
+    BasicSoAVector(size_type size, const value_type& val, const allocator_type& alloc = allocator_type())
+    :BasicSoAVector(alloc)
+    {
+        resize(size, val);
+    }
+
+    BasicSoAVector(std::initializer_list<value_type> initlist, const allocator_type& alloc = allocator_type())
+    :BasicSoAVector(alloc)
+    {
+        reserve(initlist.size());
+        for (auto& row : initlist)
+            push_back(row);
+    }
+
+    BasicSoAVector(const BasicSoAVector& rhs)
+    :BasicSoAVector(alloc_traits::select_on_container_copy_construction(rhs.alloc_))
+    {
+        reserve(rhs.used_);
+        construct_tail(rhs.used_, [&rhs, this]<size_type I>(auto& alloc, auto first, auto last, std::integral_constant<size_type, I>)
+        {
+            auto src = std::get<I>(rhs.data_) + (first - std::get<I>(data_));
+            Ranges::uninitialized_copy(alloc, src, src + (last - first), first);
+        });
+    }
+
+    BasicSoAVector(BasicSoAVector&& rhs) noexcept
+    :alloc_ {rhs.alloc_}, block_ {std::exchange(rhs.block_, nullptr)}, data_ {std::exchange(rhs.data_, {})},
+     size_ {std::exchange(rhs.size_, 0)}, used_ {std::exchange(rhs.used_, 0)}
+    {}
+
+    BasicSoAVector& operator=(const BasicSoAVector& rhs)
+    {
+        BasicSoAVector cpy (rhs);
+        swap(cpy);
+        return *this;
+    }
+
+    BasicSoAVector& operator=(BasicSoAVector&& rhs) noexcept
+    {
+        BasicSoAVector tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    ~BasicSoAVector()
+    {
+        destroy_columns(data_, 0, used_);
+        deallocate(block_, size_);
+    }
+
+    //swaps allocators along with the storage
+    void swap(BasicSoAVector& rhs) noexcept
+    {
+        using std::swap;
+        swap(alloc_, rhs.alloc_);
+        swap(block_, rhs.block_);
+        swap(data_, rhs.data_);
+        swap(size_, rhs.size_);
+        swap(used_, rhs.used_);
+    }
+
+    friend void swap(BasicSoAVector& lhs, BasicSoAVector& rhs) noexcept {lhs.swap(rhs);}
+
+    allocator_type get_allocator() const {return alloc_;}
+
+public:
+    size_type size() const {return used_;}
+    size_type capacity() const {return size_;}
+    bool empty() const {return used_ == 0;}
+
+    static constexpr size_type max_size()
+    {
+        return (std::numeric_limits<std::ptrdiff_t>::max() - columns * column_alignment) / row_bytes;
+    }
+
+    //elements of column I
+    template<size_type I>
+    std::span<column_type<I>> column() {return {std::get<I>(data_), used_};}
+    template<size_type I>
+    std::span<const column_type<I>> column() const {return {std::get<I>(data_), used_};}
+
+    reference operator[](size_type index) noexcept
+    {
+        return std::apply([index](Ts*... cols){return reference{cols[index]...};}, data_);
+    }
+    const_reference operator[](size_type index) const noexcept
+    {
+        return std::apply([index](Ts*... cols){return const_reference{cols[index]...};}, data_);
+    }
+
+    reference at(size_type index)
+    {
+        if (index >= used_)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return (*this)[index];
+    }
+    const_reference at(size_type index) const
+    {
+        if (index >= used_)
+            throw std::out_of_range{"try to get acces to element out of array"};
+        return (*this)[index];
+    }
+
+    reference front()
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return (*this)[0];
+    }
+    const_reference front() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get front from empty vector"};
+        return (*this)[0];
+    }
+
+    reference back()
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return (*this)[used_ - 1];
+    }
+    const_reference back() const
+    {
+        if (empty())
+            throw std::underflow_error{"try to get back from empty vector"};
+        return (*this)[used_ - 1];
+    }
+
+public:
+    void push_back(const value_type& val)
+    {
+        std::apply([this](const Ts&... fields){emplace_back(fields...);}, val);
+    }
+    void push_back(value_type&& val)
+    {
+        std::apply([this](Ts&... fields){emplace_back(std::move(fields)...);}, val);
+    }
+
+    //one argument per column; args may refer to elements of the vector itself
+    template<typename... Args>
+    requires (sizeof...(Args) == columns)
+    reference emplace_back(Args&&... args)
+    {
+        if (used_ == size_)
+            reallocate(next_capacity(used_ + 1), std::forward<Args>(args)...);
+        else
+            construct_row(data_, used_, std::forward<Args>(args)...);
+        return (*this)[used_++];
+    }
+
+    void pop_back()
+    {
+        if (empty())
+            throw std::underflow_error{"try to pop element from empty vector"};
+        destroy_columns(data_, used_ - 1, used_);
+        used_--;
+    }
+
+    void reserve(size_type newsz)
+    {
+        if (size_ >= newsz)
+            return;
+        reallocate(newsz);
+    }
+
+    void resize(size_type newsz)
+    {
+        resize_with(newsz, []<size_type I>(auto& alloc, auto first, auto last, std::integral_constant<size_type, I>)
+        {
+            Ranges::uninitialized_default_construct(alloc, first, last);
+        });
+    }
+
+    void resize(size_type newsz, const value_type& val)
+    {
+        resize_with(newsz, [&val]<size_type I>(auto& alloc, auto first, auto last, std::integral_constant<size_type, I>)
+        {
+            Ranges::uninitialized_fill(alloc, first, last, std::get<I>(val));
+        });
+    }
+
+    void clear()
+    {
+        destroy_columns(data_, 0, used_);
+        used_ = 0;
+    }
+
+    void shrink_to_fit()
+    {
+        if (used_ == size_)
+            return;
+        if (used_ == 0)
+        {
+            deallocate(block_, size_);
+            block_ = nullptr;
+            data_ = {};
+            size_ = 0;
+            return;
+        }
+        reallocate(used_);
+    }
+
+private:
+    template<typename Fill>
+    void resize_with(size_type newsz, Fill fill)
+    {
+        if (newsz <= used_)
+        {
+            destroy_columns(data_, newsz, used_);
+            used_ = newsz;
+            return;
+        }
+        if (newsz > size_)
+            reserve(next_capacity(newsz));
+        construct_tail(newsz, fill);
+    }
+
+public:
+    iterator begin() {return iterator{this, 0};}
+    iterator end()   {return iterator{this, used_};}
+
+    const_iterator begin() const {return const_iterator{this, 0};}
+    const_iterator end()   const {return const_iterator{this, used_};}
+
+    const_iterator cbegin() const {return const_iterator{this, 0};}
+    const_iterator cend()   const {return const_iterator{this, used_};}
+
+    reverse_iterator rbegin() {return reverse_iterator{end()};}
+    reverse_iterator rend()   {return reverse_iterator{begin()};}
+
+    const_reverse_iterator rbegin() const {return const_reverse_iterator{end()};}
+    const_reverse_iterator rend()   const {return const_reverse_iterator{begin()};}
+
+    const_reverse_iterator crbegin() const {return const_reverse_iterator{cend()};}
+    const_reverse_iterator crend()   const {return const_reverse_iterator{cbegin()};}
+}; // class BasicSoAVector
+
+template<typename... Ts>
+using SoAVector = BasicSoAVector<std::allocator<std::byte>, Ts...>;
+
+} // namespace Container
+
+template<typename... Fields>
+struct std::tuple_size<Container::detail::soa_row<Fields...>>: std::integral_constant<std::size_t, sizeof...(Fields)> {};
+
+template<std::size_t I, typename... Fields>
+struct std::tuple_element<I, Container::detail::soa_row<Fields...>>
+{
+    using type = std::tuple_element_t<I, std::tuple<Fields&...>>;
+};
@@ -0,0 +1,133 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include "parallel_policy.hpp"
+
+namespace Container
+{
+
+//fixed set of worker threads for the parallel algorithms
+class ThreadPool
+{
+    std::mutex mutex_;
+    std::deque<std::function<void()>> tasks_;
+    //one token per queued task, plus one per worker on shutdown
+    std::counting_semaphore<> pending_ {0};
+    std::vector<std::thread> workers_;
+
+    void work()
+    {
+        for (;;)
+        {
+            pending_.acquire();
+            std::function<void()> task;
+            {
+                std::lock_guard lock {mutex_};
+                if (tasks_.empty())
+                    return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    void shutdown() noexcept
+    {
+        pending_.release(workers_.size());
+        for (auto& worker : workers_)
+            worker.join();
+        workers_.clear();
+    }
+
+public:
+    //the thread that calls run() works too, so a pool of n workers runs n + 1 tasks at once
+    static std::size_t default_size() noexcept
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+    }
+
+    explicit ThreadPool(std::size_t threads = default_size())
+    {
+        workers_.reserve(threads);
+        try
+        {
+            for (std::size_t i = 0; i < threads; i++)
+                workers_.emplace_back([this]{work();});
+        }
+        catch (...)
+        {
+            shutdown();
+            throw;
+        }
+    }
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {shutdown();}
+
+    std::size_t size() const noexcept {return workers_.size();}
+
+    static ThreadPool& instance()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    //calls fn(i) for every i in [0, n) on the workers and the calling thread and returns when all calls are done;
+    //fn must not throw. Workers that get to the batch after it is drained leave without touching fn,
+    //so run() may be called from a task of the same pool
+    template<typename Fn>
+    void run(std::size_t n, Fn fn)
+    {
+        if (n == 0)
+            return;
+
+        struct batch
+        {
+            std::atomic<std::size_t> next {0}, done {0};
+            std::size_t count;
+            Fn* fn;
+        };
+        auto state = std::make_shared<batch>();
+        state->count = n;
+        state->fn = &fn;
+
+        auto drain = [state]() noexcept
+        {
+            for (auto i = state->next.fetch_add(1); i < state->count; i = state->next.fetch_add(1))
+            {
+                (*state->fn)(i);
+                if (state->done.fetch_add(1) + 1 == state->count)
+                    state->done.notify_all();
+            }
+        };
+
+        auto helpers = std::min(size(), n - 1);
+        if (helpers != 0)
+        {
+            {
+                std::lock_guard lock {mutex_};
+                for (std::size_t i = 0; i < helpers; i++)
+                    tasks_.emplace_back(drain);
+            }
+            pending_.release(helpers);
+        }
+        drain();
+        for (auto done = state->done.load(); done != n; done = state->done.load())
+            state->done.wait(done);
+    }
+};
+
+inline ThreadPool& parallel_policy::get_pool() const {return pool ? *pool : ThreadPool::instance();}
+
+} // namespace Container
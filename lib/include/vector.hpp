@@ -1,7 +1,17 @@
 #pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstring>
 #include <initializer_list>
 #include "my_ranges.hpp"
+#include "growth_policy.hpp"
+#include "instrumentation_hooks.hpp"
+#include "parallel_policy.hpp"
 #include <iterator>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <utility>
 
 namespace Container
 {
@@ -9,64 +19,72 @@ namespace Container
 namespace detail
 {
 
+//models std::contiguous_iterator, so Vector is a contiguous range: std::span and the ranges algorithms
+//see through it to the underlying array
 template<typename P>
 struct iterator
 {
+    using iterator_concept  = std::contiguous_iterator_tag;
     using iterator_category = std::random_access_iterator_tag;
     using difference_type   = std::ptrdiff_t;
-    using value_type        = std::remove_pointer_t<P>;
-    using reference         = value_type&;
+    using element_type      = std::remove_pointer_t<P>;
+    using value_type        = std::remove_cv_t<element_type>;
+    using reference         = element_type&;
     using pointer           = P;
 
 private:
     pointer ptr_;
 
 public:
-    iterator(pointer ptr = nullptr): ptr_ {ptr} {}
+    constexpr iterator(pointer ptr = nullptr): ptr_ {ptr} {}
 
-    reference operator*() const {return *ptr_;}
-    pointer operator->() const {return ptr_;}
+    template<typename Q>
+    requires std::convertible_to<Q, P>
+    constexpr iterator(const iterator<Q>& itr): ptr_ {itr.operator->()} {}
 
-    iterator& operator++()
+    constexpr reference operator*() const {return *ptr_;}
+    constexpr pointer operator->() const {return ptr_;}
+
+    constexpr iterator& operator++()
     {
         ptr_++;
         return *this;
     }
-    iterator operator++(int)
+    constexpr iterator operator++(int)
     {
         iterator tmp (*this);
         ++(*this);
         return tmp;
     }
-    iterator& operator--()
+    constexpr iterator& operator--()
     {
         ptr_--;
         return *this;
     }
-    iterator operator--(int)
+    constexpr iterator operator--(int)
     {
         iterator tmp (*this);
         --(*this);
         return tmp;
     }
 
-    iterator& operator+=(const difference_type& diff)
+    constexpr iterator& operator+=(const difference_type& diff)
     {
         ptr_ += diff;
         return *this;
     }
-    iterator& operator-=(const difference_type& diff)
+    constexpr iterator& operator-=(const difference_type& diff)
     {
         ptr_ -= diff;
         return *this;
     }
 
-    difference_type operator-(const iterator& itr) const
+    constexpr difference_type operator-(const iterator& itr) const
     {
         return ptr_ - itr.ptr_;
     }
 
-    reference operator[](const difference_type& diff) const
+    constexpr reference operator[](const difference_type& diff) const
     {
         return ptr_[diff];
     }
@@ -75,7 +93,7 @@ public:
 };
 
 template<typename P>
-iterator<P> operator+(const iterator<P>& itr, const typename iterator<P>::difference_type& diff)
+constexpr iterator<P> operator+(const iterator<P>& itr, const typename iterator<P>::difference_type& diff)
 {
     iterator itr_cpy (itr);
     itr_cpy += diff;
@@ -83,145 +101,348 @@ iterator<P> operator+(const iterator<P>& itr, const typename iterator<P>::differ
 }
 
 template<typename P>
-iterator<P> operator+(const typename iterator<P>::difference_type& diff, const iterator<P>& itr)
+constexpr iterator<P> operator+(const typename iterator<P>::difference_type& diff, const iterator<P>& itr)
 {
     return itr + diff;
 }
 
 template<typename P>
-iterator<P> operator-(const iterator<P>& itr, const typename iterator<P>::difference_type& diff)
+constexpr iterator<P> operator-(const iterator<P>& itr, const typename iterator<P>::difference_type& diff)
 {
     iterator itr_cpy (itr);
     itr_cpy -= diff;
     return itr_cpy;
 }
 
-template<typename T>
+template<typename T, typename Allocator>
 class VectorBuf
 {
-    using value_type = T;
-    using pointer    = T*;
-    using size_type  = typename std::size_t;
+    using value_type     = T;
+    using pointer        = T*;
+    using size_type      = typename std::size_t;
+    using allocator_type = Allocator;
+    using alloc_traits   = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same<typename alloc_traits::value_type, T>::value, "Allocator::value_type must be T");
 protected:
-    size_type size_, used_ = 0;
+    [[no_unique_address]] allocator_type alloc_;
+    size_type size_ = 0, used_ = 0;
     pointer data_ = nullptr;
 protected:
-    VectorBuf(size_type size = 0)
-    :size_ {size},  
-     data_ {(size_ == 0) ? nullptr : static_cast<pointer>(::operator new(sizeof(value_type) * size_))}
-    {}
+    //capacity available without any allocation
+    static constexpr size_type inline_capacity = 0;
+    static constexpr bool nothrow_swap = true;
+
+    constexpr VectorBuf(size_type size = 0, const allocator_type& alloc = allocator_type())
+    :alloc_ {alloc}
+    {
+        auto [ptr, count] = allocate_at_least(size);
+        data_ = ptr;
+        size_ = count;
+    }
 
     VectorBuf(const VectorBuf&)            = delete;
     VectorBuf& operator=(const VectorBuf&) = delete;
 
-    void swap(VectorBuf& rhs) noexcept
+    constexpr pointer allocate(size_type n)
+    {
+        return (n == 0) ? nullptr : alloc_traits::allocate(alloc_, n);
+    }
+
+    struct allocation
+    {
+        pointer ptr;
+        size_type count;
+    };
+
+    //the storage may hand out more than n elements; the caller owns all of them.
+    //with claim_slack the allocator's allocate_at_least is used when it has one
+    constexpr allocation allocate_at_least(size_type n, bool claim_slack = false)
+    {
+        if constexpr (requires (allocator_type& alloc) {alloc.allocate_at_least(n);})
+        {
+            if (claim_slack && n != 0)
+            {
+                auto [ptr, count] = alloc_.allocate_at_least(n);
+                Instrumentation::record_allocation<T>(count);
+                return {ptr, count};
+            }
+        }
+        if (n != 0)
+            Instrumentation::record_allocation<T>(n);
+        return {allocate(n), n};
+    }
+
+    constexpr void deallocate(pointer ptr, size_type n) noexcept
+    {
+        if (ptr)
+            alloc_traits::deallocate(alloc_, ptr, n);
+    }
+
+    //allocator can resize a block in place and elements may be moved bytewise along with it
+    static constexpr bool can_reallocate =
+        Ranges::relocates_bitwise_v<Allocator, T> &&
+        requires (allocator_type& alloc, pointer ptr, size_type n) {{alloc.reallocate(ptr, n, n)} -> std::same_as<pointer>;};
+
+    constexpr pointer reallocate(pointer ptr, size_type old_n, size_type new_n) requires can_reallocate
+    {
+        if (!ptr)
+            return allocate_at_least(new_n).ptr;
+        if (new_n == 0)
+        {
+            deallocate(ptr, old_n);
+            return nullptr;
+        }
+        auto new_ptr = alloc_.reallocate(ptr, old_n, new_n);
+        Instrumentation::record_allocation<T>(new_n);
+        return new_ptr;
+    }
+
+    //lets the allocator give the memory past the used elements back to the OS
+    constexpr void release_unused() noexcept
+    {
+        if constexpr (requires (allocator_type& alloc, pointer ptr, size_type n) {alloc.release_unused(ptr, n, n);})
+        {
+            if (data_)
+                alloc_.release_unused(data_, size_, used_);
+        }
+    }
+
+    constexpr void swap_data(VectorBuf& rhs) noexcept
     {
         std::swap(size_, rhs.size_);
         std::swap(used_, rhs.used_);
         std::swap(data_, rhs.data_);
     }
 
-    VectorBuf(VectorBuf&& rhs) noexcept
+    //swaps allocators regardless of propagate_on_container_swap
+    constexpr void swap(VectorBuf& rhs) noexcept
     {
-        swap(rhs);
+        using std::swap;
+        swap(alloc_, rhs.alloc_);
+        swap_data(rhs);
     }
 
-    VectorBuf& operator=(VectorBuf&& rhs) noexcept
+    constexpr VectorBuf(VectorBuf&& rhs) noexcept
+    :alloc_ {std::move(rhs.alloc_)}
     {
-        swap(rhs);
-        return *this;
+        swap_data(rhs);
     }
 
-    ~VectorBuf()
+    VectorBuf& operator=(VectorBuf&&) = delete;
+
+    constexpr ~VectorBuf()
     {
-        std::destroy(data_, data_ + used_);
-        ::operator delete(data_);
+        Ranges::destroy(alloc_, data_, data_ + used_);
+        deallocate(data_, size_);
     }
 };
 } // namespace detail
 
-template<typename T>
-class Vector final: private detail::VectorBuf<T>
+//tag for constructors that default-initialize elements, leaving trivial ones uninitialized
+struct default_init_t {explicit default_init_t() = default;};
+inline constexpr default_init_t default_init {};
+
+template<typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = Growth::Doubling,
+         typename Storage = detail::VectorBuf<T, Allocator>>
+class Vector final: private Storage
 {
 public:
     using value_type      = T;
+    using allocator_type  = Allocator;
     using pointer         = T*;
     using const_pointer   = const T*;
     using reference       = T&;
     using const_reference = const T&;
     using size_type       = std::size_t;
-    using base            = detail::VectorBuf<T>;
+    using base            = Storage;
 
     using iterator       = detail::iterator<pointer>;
     using const_iterator = detail::iterator<const_pointer>;
     using reverse_iterator       = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-private:   
+private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    using base::alloc_;
     using base::size_;
     using base::used_;
     using base::data_;
+    using base::deallocate;
+
+    static constexpr bool claim_slack = requires {requires GrowthPolicy::claim_slack;};
+    static_assert(!claim_slack || requires (Allocator& alloc, size_type n) {alloc.allocate_at_least(n);},
+                  "growth policy claims slack, but the allocator has no allocate_at_least");
 public:
-    Vector() = default;
+    constexpr Vector() = default;
+
+    constexpr explicit Vector(const allocator_type& alloc) noexcept: base(0, alloc) {}
+
+    constexpr explicit Vector(size_type size, const allocator_type& alloc = allocator_type()): base(size, alloc)
+    {
+        Ranges::uninitialized_default_construct(alloc_, data_, data_ + size);
+        used_ = size;
+    }
 
-    explicit Vector(size_type size): base(size)
+    constexpr Vector(size_type size, default_init_t, const allocator_type& alloc = allocator_type()): base(size, alloc)
     {
-        Ranges::uninitialized_default_construct(data_, data_ + size_);
-        used_ = size_;
+        Ranges::uninitialized_default_init(alloc_, data_, data_ + size);
+        used_ = size;
     }
 
-    Vector(size_type size, const_reference val): base(size)
+    constexpr Vector(size_type size, const_reference val, const allocator_type& alloc = allocator_type()): base(size, alloc)
     {
-        std::uninitialized_fill(data_, data_ + size_, val);
-        used_ = size_;
+        Ranges::uninitialized_fill(alloc_, data_, data_ + size, val);
+        used_ = size;
     }
 
     template<std::input_iterator InpIt>
-    Vector(InpIt first, InpIt last): base(std::distance(first, last))
+    constexpr Vector(InpIt first, InpIt last, const allocator_type& alloc = allocator_type())
+    :base(std::distance(first, last), alloc)
     {
-        std::uninitialized_copy(first, last, data_);
-        used_ = size_;
+        used_ = Ranges::uninitialized_copy(alloc_, first, last, data_) - data_;
     }
 
-    Vector(std::initializer_list<T> initlist)
-    :Vector(initlist.begin(), initlist.end())
+    constexpr Vector(std::initializer_list<T> initlist, const allocator_type& alloc = allocator_type())
+    :Vector(initlist.begin(), initlist.end(), alloc)
+    {}
+
+    //parallel versions construct the elements on a thread pool, see parallel_policy; code using them includes
+    //parallel_ranges.hpp
+    Vector(const parallel_policy& policy, size_type size, const allocator_type& alloc = allocator_type())
+    :base(size, alloc)
+    {
+        Ranges::uninitialized_default_construct(policy, alloc_, data_, data_ + size);
+        used_ = size;
+    }
+
+    Vector(const parallel_policy& policy, size_type size, const_reference val, const allocator_type& alloc = allocator_type())
+    :base(size, alloc)
+    {
+        Ranges::uninitialized_fill(policy, alloc_, data_, data_ + size, val);
+        used_ = size;
+    }
+
+    template<std::random_access_iterator RandIt>
+    Vector(const parallel_policy& policy, RandIt first, RandIt last, const allocator_type& alloc = allocator_type())
+    :base(last - first, alloc)
+    {
+        used_ = Ranges::uninitialized_copy(policy, alloc_, first, last, data_) - data_;
+    }
+
+    Vector(const parallel_policy& policy, const Vector& rhs)
+    :Vector(policy, rhs.data_, rhs.data_ + rhs.used_, alloc_traits::select_on_container_copy_construction(rhs.alloc_))
     {}
 
 public:
-    Vector(Vector&&)            = default;
-    Vector& operator=(Vector&&) = default;
+    constexpr Vector(Vector&&) = default;
 
-    Vector(const Vector& rhs): base(rhs.used_)
+    constexpr Vector(Vector&& rhs, const allocator_type& alloc): base(0, alloc)
     {
-        std::uninitialized_copy(rhs.data_, rhs.data_ + rhs.used_, data_);
+        if (alloc_traits::is_always_equal::value || alloc_ == rhs.alloc_)
+            base::swap_data(rhs);
+        else
+        {
+            Vector tmp (rhs.used_, alloc_, raw_storage_tag{});
+            Ranges::uninitialized_move(alloc_, rhs.data_, rhs.data_ + rhs.used_, tmp.data_);
+            tmp.used_ = rhs.used_;
+            base::swap_data(tmp);
+        }
+    }
+
+    constexpr Vector(const Vector& rhs)
+    :Vector(rhs, alloc_traits::select_on_container_copy_construction(rhs.alloc_))
+    {}
+
+    constexpr Vector(const Vector& rhs, const allocator_type& alloc): base(rhs.used_, alloc)
+    {
+        Ranges::uninitialized_copy(alloc_, rhs.data_, rhs.data_ + rhs.used_, data_);
         used_ = rhs.used_;
     }
 
-    Vector& operator=(const Vector& rhs)
+    constexpr Vector& operator=(const Vector& rhs)
     {
-        auto cpy (rhs);
-        std::swap(*this, cpy);
+        constexpr bool propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+        Vector cpy (rhs, propagate ? rhs.alloc_ : alloc_);
+        base::swap(cpy);
         return *this;
     }
 
-    ~Vector() = default;
+    constexpr Vector& operator=(Vector&& rhs)
+    noexcept(base::nothrow_swap &&
+             (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value))
+    {
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            Vector tmp (std::move(rhs));
+            base::swap(tmp);
+        }
+        else
+        {
+            Vector tmp (std::move(rhs), alloc_);
+            base::swap_data(tmp);
+        }
+        return *this;
+    }
+
+    constexpr ~Vector() = default;
+
+    constexpr void swap(Vector& rhs) noexcept(base::nothrow_swap)
+    {
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+            base::swap(rhs);
+        else
+            base::swap_data(rhs);
+    }
+
+    friend constexpr void swap(Vector& lhs, Vector& rhs) noexcept(base::nothrow_swap) {lhs.swap(rhs);}
+
+    constexpr allocator_type get_allocator() const {return alloc_;}
+
+private:
+    struct raw_storage_tag {};
+
+    //allocates capacity without constructing anything
+    constexpr Vector(size_type size, const allocator_type& alloc, raw_storage_tag): base(size, alloc) {}
 
 public:
-    size_type size() const {return used_;}
-    size_type capacity() const {return size_;}
-    bool empty() const {return used_ == 0;}
-    pointer data() {return data_;}
-    const_pointer data() const {return data_;}
-
-    reference       operator[](size_type index)       noexcept {return data_[index];}
-    const_reference operator[](size_type index) const noexcept {return data_[index];}
+    constexpr size_type size() const {return used_;}
+    constexpr size_type capacity() const {return size_;}
+    constexpr bool empty() const {return used_ == 0;}
+    constexpr pointer data() {return data_;}
+    constexpr const_pointer data() const {return data_;}
+
+    //count elements from offset, or all the rest; a view that is invalidated like an iterator
+    constexpr std::span<T> subspan(size_type offset, size_type count = std::dynamic_extent)
+    {
+        check_slice(offset, count);
+        return std::span<T>{data_, used_}.subspan(offset, count);
+    }
+    constexpr std::span<const T> subspan(size_type offset, size_type count = std::dynamic_extent) const
+    {
+        check_slice(offset, count);
+        return std::span<const T>{data_, used_}.subspan(offset, count);
+    }
+
+private:
+    constexpr void check_slice(size_type offset, size_type count) const
+    {
+        if (offset > used_ || (count != std::dynamic_extent && count > used_ - offset))
+            throw std::out_of_range{"try to get slice out of array"};
+    }
+
+public:
+
+    constexpr reference       operator[](size_type index)       noexcept {return data_[index];}
+    constexpr const_reference operator[](size_type index) const noexcept {return data_[index];}
     
-    reference at(size_type index)  
+    constexpr reference at(size_type index)  
     {
         if (index >= used_)
             throw std::out_of_range{"try to get acces to element out of array"};
         return data_[index];
     }
-    const_reference at(size_type index) const
+    constexpr const_reference at(size_type index) const
     {
         if (index >= used_)
             throw std::out_of_range{"try to get acces to element out of array"};
@@ -229,160 +450,569 @@ public:
     }
 
 public:
-    void push_back(const value_type& val)
+    constexpr void push_back(const value_type& val)
     {
-        auto cpy {val};
-        push_back(std::move(cpy));
+        emplace_back(val);
     }
 
-    void push_back(value_type&& val)
+    constexpr void push_back(value_type&& val)
+    {
+        emplace_back(std::move(val));
+    }
+
+    //args may refer to elements of the vector itself
+    template<typename... Args>
+    constexpr reference emplace_back(Args&&... args)
     {
         if (need_reserve_up())
-            reserve(2 * size_ + 1);
-        
-        std::construct_at(data_ + used_++, std::move(val));
+            return *realloc_emplace(used_, std::forward<Args>(args)...);
+
+        alloc_traits::construct(alloc_, data_ + used_, std::forward<Args>(args)...);
+        return data_[used_++];
     }
 
 private:
-    bool need_reserve_up() const {return (used_ == size_);}
+    constexpr bool need_reserve_up() const {return (used_ == size_);}
+
+    constexpr size_type next_capacity(size_type required) const
+    {
+        return std::max(GrowthPolicy::next_capacity(size_, required, sizeof(value_type)), required);
+    }
 
 public:
-    const_reference back() const
+    constexpr const_reference back() const
     {
         if (empty())
             throw std::underflow_error{"try to get back from empty vector"};
         return data_[used_ - 1];
     }
 
-    reference back()
+    constexpr reference back()
     {
         if (empty())
             throw std::underflow_error{"try to get back from empty vector"};
         return data_[used_ - 1];
     }
 
-    const_reference front() const
+    constexpr const_reference front() const
     {
         if (empty())
             throw std::underflow_error{"try to get back from empty vector"};
         return data_[0];
     }
 
-    reference front()
+    constexpr reference front()
     {
         if (empty())
             throw std::underflow_error{"try to get back from empty vector"};
         return data_[0];
     }
 
-    void pop_back()
+    constexpr void pop_back()
     {
         if(empty())
             throw std::underflow_error{"try to pop element from empty vector"};
         used_--;
-        std::destroy_at(data_ + used_);
+        alloc_traits::destroy(alloc_, data_ + used_);
     }
 
 private:
-    struct raw_deleter {void operator()(void* ptr) const {::operator delete(ptr);}};
-    using scoped_raw_ptr = std::unique_ptr<value_type, raw_deleter>;
+    //owns a fresh block until release(); std::unique_ptr is not constexpr in C++20
+    class scoped_raw_ptr
+    {
+        Vector* vec_;
+        pointer ptr_;
+        size_type n_;
+
+    public:
+        constexpr scoped_raw_ptr(Vector* vec, pointer ptr, size_type n): vec_ {vec}, ptr_ {ptr}, n_ {n} {}
+        scoped_raw_ptr(const scoped_raw_ptr&) = delete;
+        scoped_raw_ptr& operator=(const scoped_raw_ptr&) = delete;
+        constexpr ~scoped_raw_ptr() {vec_->deallocate(ptr_, n_);}
+
+        constexpr pointer get() const {return ptr_;}
+        constexpr size_type capacity() const {return n_;}
+        constexpr pointer release() {return std::exchange(ptr_, nullptr);}
+    };
+
+    //capacity of the new block is capacity()
+    constexpr scoped_raw_ptr allocate_scoped(size_type n)
+    {
+        auto [ptr, count] = base::allocate_at_least(n, claim_slack);
+        return scoped_raw_ptr {this, ptr, count};
+    }
+
+    constexpr void record_relocation(size_type n) const {Instrumentation::record_relocation<T, Allocator>(n);}
 
 public:
-    void reserve(size_type newsz)
+    constexpr void reserve(size_type newsz)
     {
         if (size_ >= newsz)
             return;
-        
-        scoped_raw_ptr new_data_scoped {static_cast<pointer>(::operator new(sizeof(value_type) * newsz))};
-        auto new_data = new_data_scoped.get();
-        Ranges::strong_guarantee_uninitialized_move_or_copy(data_, data_ + used_, new_data);
 
-        std::destroy(data_, data_ + used_);
-        ::operator delete(data_);
-        data_ = new_data_scoped.release();
+        if constexpr (base::can_reallocate)
+            data_ = base::reallocate(data_, size_, newsz);
+        else
+        {
+            auto new_data_scoped = allocate_scoped(newsz);
+            Ranges::uninitialized_relocate(alloc_, data_, data_ + used_, new_data_scoped.get());
+            record_relocation(used_);
+
+            deallocate(data_, size_);
+            newsz = new_data_scoped.capacity();
+            data_ = new_data_scoped.release();
+        }
         size_ = newsz;
+        Instrumentation::record_reallocation<T>(Instrumentation::Reallocation::reserve);
     }
 
 private:
+    constexpr void truncate(size_type newsz) noexcept
+    {
+        Ranges::destroy(alloc_, data_ + newsz, data_ + used_);
+        used_ = newsz;
+        base::release_unused();
+    }
+
     template<class Initializer>
-    void resize(size_type newsz, Initializer initializer)
+    constexpr void resize_with(size_type newsz, Initializer initializer)
     {
         if (newsz <= used_)
-            std::destroy(data_ + newsz, data_ + used_);
-        else if (newsz > used_ && newsz <= size_)
+            return truncate(newsz);
+        else if (newsz <= size_)
+            initializer(data_ + used_, data_ + newsz);
+        else if constexpr (base::can_reallocate)
+        {
+            //elements stay intact if the initializer throws, only the capacity grows
+            data_ = base::reallocate(data_, size_, newsz);
+            size_ = newsz;
+            Instrumentation::record_reallocation<T>(Instrumentation::Reallocation::resize);
             initializer(data_ + used_, data_ + newsz);
+        }
         else
         {
-            scoped_raw_ptr new_data_scoped {static_cast<pointer>(::operator new(sizeof(value_type) * newsz))};
+            auto new_data_scoped = allocate_scoped(newsz);
             auto new_data = new_data_scoped.get();
-            Ranges::strong_guarantee_uninitialized_move_or_copy(data_, data_ + used_, new_data);
-            try 
+            //construct the tail first, so relocation is the last step that may throw
+            initializer(new_data + used_, new_data + newsz);
+            try
             {
-                initializer(new_data + used_, new_data + newsz);
+                Ranges::uninitialized_relocate(alloc_, data_, data_ + used_, new_data);
             }
             catch (...)
             {
-                if constexpr ((!std::is_copy_constructible<value_type>::value || 
-                std::is_nothrow_move_constructible<value_type>::value) && std::is_nothrow_move_assignable<value_type>::value)
-                    std::move(new_data, new_data + used_, data_);
-                std::destroy(new_data, new_data + used_);
+                Ranges::destroy(alloc_, new_data + used_, new_data + newsz);
                 throw;
             }
-            std::destroy(data_, data_ + used_);
-            ::operator delete(data_);
+            record_relocation(used_);
+            deallocate(data_, size_);
+            size_ = new_data_scoped.capacity();
             data_ = new_data_scoped.release();
-            size_ = newsz;
-        } 
+            Instrumentation::record_reallocation<T>(Instrumentation::Reallocation::resize);
+        }
         used_ = newsz;
     }
 
+    //value may refer to an element of the block reallocate frees, so growing in place fills from a copy
+    template<class Fill>
+    constexpr void resize_fill(size_type newsz, const_reference value, Fill fill)
+    {
+        if constexpr (base::can_reallocate)
+        {
+            if (newsz > size_)
+            {
+                value_type tmp (value);
+                return resize_with(newsz, [&fill, &tmp](pointer first, pointer last){fill(first, last, tmp);});
+            }
+        }
+        resize_with(newsz, [&fill, &value](pointer first, pointer last){fill(first, last, value);});
+    }
+
 public:
-    void resize(size_type newsz)
+    constexpr void resize(size_type newsz)
     {
-        resize(newsz, [](pointer first, pointer last){Ranges::uninitialized_default_construct(first, last);});
+        resize_with(newsz, [this](pointer first, pointer last){Ranges::uninitialized_default_construct(alloc_, first, last);});
     }
 
-    void resize(size_type newsz, const_reference value)
+    constexpr void resize(size_type newsz, const_reference value)
     {
-        resize(newsz, [&value](pointer first, pointer last){std::uninitialized_fill(first, last, value);});
+        resize_fill(newsz, value, [this](pointer first, pointer last, const_reference val)
+        {
+            Ranges::uninitialized_fill(alloc_, first, last, val);
+        });
     }
 
-    void shrink_to_fit()
+    void resize(const parallel_policy& policy, size_type newsz)
     {
-        scoped_raw_ptr new_data_scoped {static_cast<pointer>(::operator new(sizeof(value_type) * used_))};
-        auto new_data = new_data_scoped.get();
-        Ranges::strong_guarantee_uninitialized_move_or_copy(data_, data_ + used_, new_data);
+        resize_with(newsz, [this, &policy](pointer first, pointer last)
+        {
+            Ranges::uninitialized_default_construct(policy, alloc_, first, last);
+        });
+    }
 
-        std::destroy(data_, data_ + used_);
-        ::operator delete(data_);
+    void resize(const parallel_policy& policy, size_type newsz, const_reference value)
+    {
+        resize_fill(newsz, value, [this, &policy](pointer first, pointer last, const_reference val)
+        {
+            Ranges::uninitialized_fill(policy, alloc_, first, last, val);
+        });
+    }
+
+    //new elements are default-initialized, so trivial ones keep whatever the memory held
+    constexpr void resize_for_overwrite(size_type newsz)
+    {
+        resize_with(newsz, [this](pointer first, pointer last){Ranges::uninitialized_default_init(alloc_, first, last);});
+    }
+
+    //grows to at least newsz elements without initializing trivial ones, then calls op(data(), newsz),
+    //which fills the buffer and returns the number of leading elements to keep (at most newsz);
+    //the old size is restored if op throws
+    template<typename Operation>
+    constexpr void resize_and_overwrite(size_type newsz, Operation op)
+    {
+        auto old_used = used_;
+        if (newsz > used_)
+            resize_for_overwrite(newsz);
+
+        size_type keep = 0;
+        try
+        {
+            keep = static_cast<size_type>(std::move(op)(data_, newsz));
+        }
+        catch (...)
+        {
+            truncate(old_used);
+            throw;
+        }
+        if (keep > newsz)
+        {
+            truncate(old_used);
+            throw std::length_error{"resize_and_overwrite operation kept more elements than requested"};
+        }
+        truncate(keep);
+    }
+
+    constexpr void shrink_to_fit()
+    {
+        if (used_ == size_ || size_ <= base::inline_capacity)
+            return;
+
+        if constexpr (base::can_reallocate)
+        {
+            data_ = base::reallocate(data_, size_, used_);
+            size_ = used_;
+        }
+        else
+        {
+            auto new_data_scoped = allocate_scoped(used_);
+            Ranges::uninitialized_relocate(alloc_, data_, data_ + used_, new_data_scoped.get());
+            record_relocation(used_);
+
+            deallocate(data_, size_);
+            size_ = new_data_scoped.capacity();
+            data_ = new_data_scoped.release();
+        }
+        Instrumentation::record_reallocation<T>(Instrumentation::Reallocation::shrink_to_fit);
+    }
+
+private:
+    //moves [0, pos) to new_data and [pos, used_) to new_data + pos + gap and destroys the old elements;
+    //the old elements are left intact on exception
+    constexpr void relocate_with_gap(pointer new_data, size_type pos, size_type gap)
+    {
+        if constexpr (Ranges::relocates_bitwise_v<Allocator, T>)
+        {
+            Ranges::uninitialized_relocate(alloc_, data_, data_ + pos, new_data);
+            Ranges::uninitialized_relocate(alloc_, data_ + pos, data_ + used_, new_data + pos + gap);
+        }
+        else
+        {
+            Ranges::strong_guarantee_uninitialized_move_or_copy(alloc_, data_, data_ + pos, new_data);
+            try
+            {
+                Ranges::strong_guarantee_uninitialized_move_or_copy(alloc_, data_ + pos, data_ + used_, new_data + pos + gap);
+            }
+            catch (...)
+            {
+                Ranges::destroy(alloc_, new_data, new_data + pos);
+                throw;
+            }
+            Ranges::destroy(alloc_, data_, data_ + used_);
+        }
+        record_relocation(used_);
+        Instrumentation::record_reallocation<T>(Instrumentation::Reallocation::growth);
+    }
+
+    //grows the block the allocator can resize in place, for elements appended at the end
+    constexpr void reallocate_for_growth(size_type required) requires base::can_reallocate
+    {
+        auto newsz = next_capacity(required);
+        data_ = base::reallocate(data_, size_, newsz);
+        size_ = newsz;
+        Instrumentation::record_reallocation<T>(Instrumentation::Reallocation::growth);
+    }
+
+    template<typename... Args>
+    constexpr pointer realloc_emplace(size_type pos, Args&&... args)
+    {
+        if constexpr (base::can_reallocate)
+        {
+            if (pos == used_)
+            {
+                //args may refer to elements of the old block, which reallocate may move
+                value_type tmp (std::forward<Args>(args)...);
+                reallocate_for_growth(used_ + 1);
+                alloc_traits::construct(alloc_, data_ + pos, std::move(tmp));
+                return data_ + used_++;
+            }
+        }
+        auto new_data_scoped = allocate_scoped(next_capacity(used_ + 1));
+        auto new_data = new_data_scoped.get();
+        alloc_traits::construct(alloc_, new_data + pos, std::forward<Args>(args)...);
+        try
+        {
+            relocate_with_gap(new_data, pos, 1);
+        }
+        catch (...)
+        {
+            alloc_traits::destroy(alloc_, new_data + pos);
+            throw;
+        }
+        deallocate(data_, size_);
+        size_ = new_data_scoped.capacity();
         data_ = new_data_scoped.release();
-        size_ = used_;
+        used_++;
+        return data_ + pos;
     }
 
-    void clear()
+    //inserts count elements before pos; construct(dst, offset, n) builds elements [offset, offset + n)
+    //of the inserted sequence in uninitialized memory at dst, assign(dst, offset, n) assigns them over live ones
+    //and is generic, so types that are only relocated never need to be assignable
+    template<typename Construct, typename Assign>
+    constexpr iterator insert_with(size_type pos, size_type count, Construct construct, Assign assign)
     {
-        std::destroy(data_, data_ + used_);
-        used_ = 0;
+        if (count == 0)
+            return iterator{data_ + pos};
+
+        if constexpr (base::can_reallocate)
+        {
+            if (size_ - used_ < count && pos == used_)
+                reallocate_for_growth(used_ + count);
+        }
+        if (size_ - used_ < count)
+        {
+            auto new_data_scoped = allocate_scoped(next_capacity(used_ + count));
+            auto new_data = new_data_scoped.get();
+            construct(new_data + pos, 0, count);
+            try
+            {
+                relocate_with_gap(new_data, pos, count);
+            }
+            catch (...)
+            {
+                Ranges::destroy(alloc_, new_data + pos, new_data + pos + count);
+                throw;
+            }
+            deallocate(data_, size_);
+            size_ = new_data_scoped.capacity();
+            data_ = new_data_scoped.release();
+        }
+        else if constexpr (Ranges::relocates_bitwise_v<Allocator, T>)
+        {
+            Ranges::relocate_overlapping(alloc_, data_ + pos, data_ + used_, data_ + pos + count);
+            try
+            {
+                construct(data_ + pos, 0, count);
+            }
+            catch (...)
+            {
+                Ranges::relocate_overlapping(alloc_, data_ + pos + count, data_ + used_ + count, data_ + pos);
+                throw;
+            }
+        }
+        else
+        {
+            auto old_end = data_ + used_;
+            auto after = used_ - pos;
+            if (after > count)
+            {
+                Ranges::uninitialized_move(alloc_, old_end - count, old_end, old_end);
+                used_ += count;
+                std::move_backward(data_ + pos, old_end - count, old_end);
+                assign(data_ + pos, 0, count);
+                return iterator{data_ + pos};
+            }
+            construct(old_end, after, count - after);
+            try
+            {
+                Ranges::uninitialized_move(alloc_, data_ + pos, old_end, data_ + pos + count);
+            }
+            catch (...)
+            {
+                Ranges::destroy(alloc_, old_end, old_end + count - after);
+                throw;
+            }
+            used_ += count;
+            assign(data_ + pos, 0, after);
+            return iterator{data_ + pos};
+        }
+        used_ += count;
+        return iterator{data_ + pos};
+    }
+
+    constexpr size_type index_of(const_iterator pos) const {return pos - cbegin();}
+
+public:
+    template<typename... Args>
+    constexpr iterator emplace(const_iterator pos, Args&&... args)
+    {
+        auto index = index_of(pos);
+        if (index == used_)
+            return iterator{&emplace_back(std::forward<Args>(args)...)};
+        if (need_reserve_up())
+            return iterator{realloc_emplace(index, std::forward<Args>(args)...)};
+
+        value_type tmp (std::forward<Args>(args)...);
+        return insert_with(index, 1,
+            [&tmp, this](pointer dst, size_type, size_type n)
+            {
+                if (n != 0)
+                    alloc_traits::construct(alloc_, dst, std::move(tmp));
+            },
+            [&tmp](auto dst, auto, auto n)
+            {
+                if (n != 0)
+                    *dst = std::move(tmp);
+            });
+    }
+
+    constexpr iterator insert(const_iterator pos, const value_type& val) {return emplace(pos, val);}
+    constexpr iterator insert(const_iterator pos, value_type&& val) {return emplace(pos, std::move(val));}
+
+    constexpr iterator insert(const_iterator pos, size_type count, const value_type& val)
+    {
+        auto index = index_of(pos);
+        if (count == 0)
+            return iterator{data_ + index};
+
+        value_type tmp (val);
+        return insert_with(index, count,
+            [&tmp, this](pointer dst, size_type, size_type n){Ranges::uninitialized_fill(alloc_, dst, dst + n, tmp);},
+            [&tmp](auto dst, auto, auto n){std::fill(dst, dst + n, tmp);});
+    }
+
+    template<std::input_iterator InpIt>
+    constexpr iterator insert(const_iterator pos, InpIt first, InpIt last)
+    {
+        auto index = index_of(pos);
+        if constexpr (std::forward_iterator<InpIt>)
+        {
+            auto count = static_cast<size_type>(std::distance(first, last));
+            return insert_with(index, count,
+                [first, this](pointer dst, size_type offset, size_type n)
+                {
+                    auto src = std::next(first, offset);
+                    Ranges::uninitialized_copy(alloc_, src, std::next(src, n), dst);
+                },
+                [first](auto dst, auto offset, auto n)
+                {
+                    auto src = std::next(first, offset);
+                    std::copy(src, std::next(src, n), dst);
+                });
+        }
+        else
+        {
+            auto old_size = used_;
+            for (; first != last; ++first)
+                emplace_back(*first);
+            std::rotate(data_ + index, data_ + old_size, data_ + used_);
+            return iterator{data_ + index};
+        }
     }
 
-    iterator begin() {return iterator{data_};}
-    iterator end()   {return iterator{data_ + used_};}
+    constexpr iterator insert(const_iterator pos, std::initializer_list<T> initlist)
+    {
+        return insert(pos, initlist.begin(), initlist.end());
+    }
 
-    const_iterator begin() const {return const_iterator{data_};}
-    const_iterator end()   const {return const_iterator{data_ + used_};}
+    constexpr iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
 
-    const_iterator cbegin() const {return const_iterator{data_};}
-    const_iterator cend()   const {return const_iterator{data_ + used_};}
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        auto index = index_of(first), count = static_cast<size_type>(last - first);
+        if (count == 0)
+            return iterator{data_ + index};
 
-    reverse_iterator rbegin() {return reverse_iterator{data_ + used_};}
-    reverse_iterator rend()   {return reverse_iterator{data_};}
+        auto first_ptr = data_ + index, last_ptr = first_ptr + count;
+        if constexpr (Ranges::relocates_bitwise_v<Allocator, T>)
+        {
+            Ranges::destroy(alloc_, first_ptr, last_ptr);
+            Ranges::relocate_overlapping(alloc_, last_ptr, data_ + used_, first_ptr);
+        }
+        else
+        {
+            std::move(last_ptr, data_ + used_, first_ptr);
+            Ranges::destroy(alloc_, data_ + used_ - count, data_ + used_);
+        }
+        used_ -= count;
+        return iterator{first_ptr};
+    }
 
-    const_reverse_iterator rbegin() const {return const_reverse_iterator{data_ + used_};}
-    const_reverse_iterator rend()   const {return const_reverse_iterator{data_};}
+    //O(1) erase that moves the last element into pos and does not keep the order
+    constexpr iterator swap_remove(const_iterator pos)
+    {
+        auto index = index_of(pos);
+        if (index != used_ - 1)
+            data_[index] = std::move(data_[used_ - 1]);
+        pop_back();
+        return iterator{data_ + index};
+    }
 
-    const_reverse_iterator crbegin() const {return const_reverse_iterator{data_ + used_};}
-    const_reverse_iterator crend()   const {return const_reverse_iterator{data_};}
+    constexpr void clear()
+    {
+        truncate(0);
+    }
+
+    constexpr iterator begin() {return iterator{data_};}
+    constexpr iterator end()   {return iterator{data_ + used_};}
+
+    constexpr const_iterator begin() const {return const_iterator{data_};}
+    constexpr const_iterator end()   const {return const_iterator{data_ + used_};}
+
+    constexpr const_iterator cbegin() const {return const_iterator{data_};}
+    constexpr const_iterator cend()   const {return const_iterator{data_ + used_};}
+
+    constexpr reverse_iterator rbegin() {return reverse_iterator{data_ + used_};}
+    constexpr reverse_iterator rend()   {return reverse_iterator{data_};}
+
+    constexpr const_reverse_iterator rbegin() const {return const_reverse_iterator{data_ + used_};}
+    constexpr const_reverse_iterator rend()   const {return const_reverse_iterator{data_};}
+
+    constexpr const_reverse_iterator crbegin() const {return const_reverse_iterator{data_ + used_};}
+    constexpr const_reverse_iterator crend()   const {return const_reverse_iterator{data_};}
 
 }; // class Vector
 
+//object representation of the elements
+template<typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+std::span<const std::byte> as_bytes(const Vector<T, Allocator, GrowthPolicy, Storage>& vec) noexcept
+{
+    return std::as_bytes(std::span<const T>{vec});
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy, typename Storage>
+std::span<std::byte> as_writable_bytes(Vector<T, Allocator, GrowthPolicy, Storage>& vec) noexcept
+{
+    return std::as_writable_bytes(std::span<T>{vec});
+}
+
+namespace pmr
+{
+template<typename T>
+using Vector = Container::Vector<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
+
 } // namespace Container
\ No newline at end of file
@@ -6,6 +6,7 @@ stdenv.mkDerivation {
   nativeBuildInputs = with pkgs; [
     cmake
     gtest
+    gbenchmark
   ];
   doCheck = true;
 }
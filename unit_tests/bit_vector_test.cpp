@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "bit_vector.hpp"
+
+namespace
+{
+
+using Container::BitVector;
+
+BitVector random_bits(std::size_t size, unsigned seed, unsigned one_in = 2)
+{
+    std::mt19937 gen {seed};
+    BitVector bits;
+    for (std::size_t i = 0; i < size; i++)
+        bits.push_back(gen() % one_in == 0);
+    return bits;
+}
+
+std::vector<bool> to_std(const BitVector& bits) {return std::vector<bool>(bits.begin(), bits.end());}
+
+} // namespace
+
+TEST(BitVector, proxies)
+{
+    BitVector bits {true, false, true};
+    EXPECT_EQ(bits.size(), 3);
+    EXPECT_TRUE(bits[0]);
+    EXPECT_FALSE(bits[1]);
+
+    bits[1] = true;
+    bits[0] = bits[1] && false;
+    EXPECT_EQ(to_std(bits), (std::vector<bool>{false, true, true}));
+
+    swap(bits[0], bits[2]);
+    bits.back().flip();
+    EXPECT_EQ(to_std(bits), (std::vector<bool>{true, true, true}));
+
+    std::fill(bits.begin(), bits.end(), true);
+    EXPECT_TRUE(bits.all());
+    std::reverse(bits.begin(), bits.end());
+    EXPECT_EQ(std::count(bits.cbegin(), bits.cend(), true), 3);
+
+    EXPECT_THROW(bits.at(3), std::out_of_range);
+    EXPECT_THROW(BitVector{}.front(), std::underflow_error);
+    EXPECT_THROW(BitVector{}.pop_back(), std::underflow_error);
+}
+
+TEST(BitVector, growth)
+{
+    BitVector bits;
+    std::vector<bool> expected;
+    for (int i = 0; i < 300; i++)
+    {
+        bits.push_back(i % 3 == 0);
+        expected.push_back(i % 3 == 0);
+    }
+    EXPECT_EQ(to_std(bits), expected);
+    EXPECT_EQ(bits.words().size(), 5);
+    EXPECT_GE(bits.capacity(), 300);
+
+    for (int i = 0; i < 100; i++)
+    {
+        bits.pop_back();
+        expected.pop_back();
+    }
+    EXPECT_EQ(to_std(bits), expected);
+    EXPECT_EQ(bits.words().size(), 4);
+
+    bits.resize(250, true);
+    expected.resize(250, true);
+    EXPECT_EQ(to_std(bits), expected);
+    bits.resize(70);
+    expected.resize(70);
+    EXPECT_EQ(to_std(bits), expected);
+    //bits past the size are cleared, so the new ones read false
+    bits.resize(128);
+    expected.resize(128);
+    EXPECT_EQ(to_std(bits), expected);
+    EXPECT_EQ(bits.count(), static_cast<std::size_t>(std::count(expected.begin(), expected.end(), true)));
+
+    BitVector ones (130, true);
+    EXPECT_EQ(ones.count(), 130);
+    EXPECT_EQ(ones.words()[2], 3);
+}
+
+TEST(BitVector, wordOperations)
+{
+    auto lhs = random_bits(1000, 1), rhs = random_bits(1000, 2);
+    auto l = to_std(lhs), r = to_std(rhs);
+
+    auto check = [&](const BitVector& result, auto op)
+    {
+        for (std::size_t i = 0; i < l.size(); i++)
+            if (result[i] != op(l[i], r[i]))
+                return false;
+        return true;
+    };
+    EXPECT_TRUE(check(lhs & rhs, [](bool a, bool b){return a && b;}));
+    EXPECT_TRUE(check(lhs | rhs, [](bool a, bool b){return a || b;}));
+    EXPECT_TRUE(check(lhs ^ rhs, [](bool a, bool b){return a != b;}));
+    EXPECT_TRUE(check(BitVector{lhs}.and_not(rhs), [](bool a, bool b){return a && !b;}));
+    EXPECT_TRUE(check(~lhs, [](bool a, bool){return !a;}));
+    EXPECT_EQ((~lhs).count(), 1000 - lhs.count());
+    EXPECT_EQ((lhs ^ lhs).count(), 0);
+    EXPECT_EQ(lhs, BitVector{lhs});
+    EXPECT_FALSE(lhs == rhs);
+
+    EXPECT_THROW(lhs &= BitVector(999), std::invalid_argument);
+
+    BitVector sparse (500);
+    sparse.set(3);
+    sparse.set(64);
+    sparse.set(499);
+    EXPECT_EQ(sparse.find_first(), 3);
+    EXPECT_EQ(sparse.find_next(4), 64);
+    EXPECT_EQ(sparse.find_next(65), 499);
+    EXPECT_EQ(sparse.find_next(500), BitVector::npos);
+    sparse.reset(499);
+    EXPECT_EQ(sparse.find_next(65), BitVector::npos);
+}
+
+TEST(BitVector, popcountKernels)
+{
+    using Container::Numeric::Isa;
+    auto bits = random_bits(100003, 3);
+    auto expected = static_cast<std::size_t>(std::count(bits.begin(), bits.end(), true));
+    EXPECT_EQ(bits.count(), expected);
+    for (auto isa : {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512})
+    {
+        if (!Container::Numeric::supported(isa))
+        {
+            EXPECT_THROW(Container::popcount_kernel(isa), std::invalid_argument);
+            continue;
+        }
+        auto kernel = Container::popcount_kernel(isa);
+        for (std::size_t n : {0, 1, 3, 4, 7, 8, 9, 31, 1563})
+            EXPECT_EQ(kernel(bits.data(), n), Container::detail::scalar_popcount(bits.data(), n));
+    }
+}
+
+TEST(BitVector, rankSelect)
+{
+    for (unsigned one_in : {1u, 2u, 50u})
+        for (std::size_t size : {0u, 1u, 63u, 64u, 511u, 512u, 513u, 5000u})
+        {
+            auto bits = random_bits(size, size + one_in, one_in);
+            Container::RankSelect index {bits};
+            std::size_t ones = 0, zeros = 0;
+            for (std::size_t i = 0; i < size; i++)
+            {
+                ASSERT_EQ(index.rank1(i), ones);
+                ASSERT_EQ(index.rank0(i), zeros);
+                if (bits[i])
+                    ASSERT_EQ(index.select1(ones++), i);
+                else
+                    ASSERT_EQ(index.select0(zeros++), i);
+            }
+            EXPECT_EQ(index.rank1(size), ones);
+            EXPECT_EQ(index.ones(), ones);
+            EXPECT_THROW(index.select1(ones), std::out_of_range);
+            EXPECT_THROW(index.select0(zeros), std::out_of_range);
+            EXPECT_THROW(index.rank1(size + 1), std::out_of_range);
+        }
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "concurrent_vector.hpp"
+
+namespace
+{
+
+struct Counted
+{
+    static inline int alive;
+    int val;
+
+    Counted(int v): val {v}
+    {
+        if (v < 0)
+            throw std::invalid_argument{"negative"};
+        alive++;
+    }
+    Counted(const Counted& rhs): val {rhs.val} {alive++;}
+    ~Counted() {alive--;}
+};
+
+std::atomic<int> element_allocations;
+
+//counts the segments allocated for the elements
+template<typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        if constexpr (std::is_same_v<T, std::uint64_t>)
+            element_allocations++;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept {std::allocator<T>{}.deallocate(ptr, n);}
+
+    friend bool operator==(const CountingAllocator&, const CountingAllocator&) noexcept {return true;}
+};
+
+} // namespace
+
+TEST(ConcurrentVector, singleThread)
+{
+    Container::ConcurrentVector<std::string, std::allocator<std::string>, 4> vec;
+    EXPECT_TRUE(vec.empty());
+    auto& first = vec.push_back("0");
+    for (int i = 1; i < 1000; i++)
+        vec.emplace_back(std::to_string(i));
+    EXPECT_EQ(&first, &vec[0]);
+    EXPECT_EQ(vec.size(), 1000);
+    EXPECT_GE(vec.capacity(), 1000);
+
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(vec[i], std::to_string(i));
+    EXPECT_EQ(*vec.get(999), "999");
+    EXPECT_EQ(vec.get(1000), nullptr);
+    EXPECT_THROW(vec.at(1000), std::out_of_range);
+
+    auto itr = std::find(vec.begin(), vec.end(), "500");
+    EXPECT_EQ(itr - vec.begin(), 500);
+    EXPECT_EQ(itr[3], "503");
+    EXPECT_EQ(*vec.crbegin(), "999");
+    EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cbegin() + 10));
+
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    vec.push_back("again");
+    EXPECT_EQ(vec[0], "again");
+}
+
+TEST(ConcurrentVector, threads)
+{
+    constexpr int threads = 8, per_thread = 20000;
+    element_allocations = 0;
+    Container::ConcurrentVector<std::uint64_t, CountingAllocator<std::uint64_t>> vec;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&vec, t]
+        {
+            for (int i = 0; i < per_thread; i++)
+            {
+                auto& ref = vec.push_back(std::uint64_t(t) * per_thread + i);
+                ASSERT_EQ(ref, std::uint64_t(t) * per_thread + i);
+            }
+        });
+    for (auto& worker : workers)
+        worker.join();
+
+    ASSERT_EQ(vec.size(), threads * per_thread);
+    std::vector<std::uint64_t> values (vec.begin(), vec.end());
+    std::sort(values.begin(), values.end());
+    for (std::uint64_t i = 0; i < values.size(); i++)
+        EXPECT_EQ(values[i], i);
+
+    //threads crossing into a new segment together allocate it once
+    int segments = 0;
+    for (std::size_t capacity = 0; capacity < vec.capacity(); capacity += std::size_t{32} << segments)
+        segments++;
+    EXPECT_EQ(element_allocations, segments);
+}
+
+TEST(ConcurrentVector, exceptions)
+{
+    Counted::alive = 0;
+    {
+        Container::ConcurrentVector<Counted> vec;
+        vec.reserve(100);
+        EXPECT_GE(vec.capacity(), 100);
+        vec.emplace_back(1);
+        EXPECT_THROW(vec.emplace_back(-1), std::invalid_argument);
+        vec.emplace_back(3);
+        EXPECT_EQ(vec.size(), 3);
+        EXPECT_EQ(vec.get(1), nullptr);
+        EXPECT_THROW(vec.at(1), std::out_of_range);
+        EXPECT_EQ(vec.at(2).val, 3);
+        EXPECT_EQ(Counted::alive, 2);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "inplace_vector.hpp"
+#include "small_vector.hpp"
+
+namespace
+{
+
+using Ints = Container::Vector<int>;
+
+static_assert(std::contiguous_iterator<Ints::iterator>);
+static_assert(std::contiguous_iterator<Ints::const_iterator>);
+static_assert(std::same_as<std::iter_value_t<Ints::const_iterator>, int>);
+static_assert(std::same_as<std::iter_reference_t<Ints::const_iterator>, const int&>);
+static_assert(std::ranges::contiguous_range<Ints>);
+static_assert(std::ranges::contiguous_range<const Ints>);
+static_assert(std::ranges::sized_range<Ints>);
+static_assert(std::ranges::contiguous_range<Container::SmallVector<std::string, 4>>);
+static_assert(std::ranges::contiguous_range<Container::InplaceVector<int, 4>>);
+static_assert(std::is_constructible_v<std::span<int>, Ints&>);
+static_assert(!std::is_constructible_v<std::span<int>, const Ints&>);
+
+constexpr bool constant_copy()
+{
+    Container::Vector<int> src {1, 2, 3}, dst (3);
+    Ranges::copy(src.begin(), src.end(), dst.begin());
+    return Ranges::equal(src.begin(), src.end(), dst.begin(), dst.end());
+}
+static_assert(constant_copy());
+
+} // namespace
+
+TEST(Contiguous, spans)
+{
+    Ints vec {0, 1, 2, 3, 4, 5, 6, 7};
+    std::span<int> all = vec;
+    EXPECT_EQ(all.data(), vec.data());
+    EXPECT_EQ(all.size(), vec.size());
+    EXPECT_EQ(std::to_address(vec.cbegin() + 3), vec.data() + 3);
+
+    auto middle = vec.subspan(2, 4);
+    EXPECT_EQ(middle.data(), vec.data() + 2);
+    EXPECT_EQ(middle.size(), 4);
+    middle[0] = 20;
+    EXPECT_EQ(vec[2], 20);
+    EXPECT_EQ(vec.subspan(5).size(), 3);
+    EXPECT_TRUE(vec.subspan(8).empty());
+    EXPECT_THROW(vec.subspan(9), std::out_of_range);
+    EXPECT_THROW(vec.subspan(4, 5), std::out_of_range);
+
+    const auto& cvec = vec;
+    std::span<const int> view = cvec.subspan(1, 2);
+    EXPECT_EQ(view[1], 20);
+
+    auto bytes = Container::as_bytes(vec);
+    EXPECT_EQ(bytes.size(), vec.size() * sizeof(int));
+    EXPECT_EQ(static_cast<const void*>(bytes.data()), static_cast<const void*>(vec.data()));
+    Container::as_writable_bytes(vec)[0] = std::byte{0};
+    Container::as_writable_bytes(vec)[sizeof(int) - 1] = std::byte{0};
+    EXPECT_EQ(vec[0], 0);
+
+    auto evens = vec | std::views::filter([](int i){return i % 2 == 0;});
+    EXPECT_EQ(std::ranges::distance(evens), 4);
+}
+
+TEST(Contiguous, bulkAlgorithms)
+{
+    Container::Vector<std::uint32_t> src (1000), dst (1000);
+    for (std::uint32_t i = 0; i < src.size(); i++)
+        src[i] = i * 7;
+    EXPECT_EQ(Ranges::copy(src.begin(), src.end(), dst.begin()), dst.end());
+    EXPECT_TRUE(Ranges::equal(src.begin(), src.end(), dst.begin(), dst.end()));
+    dst[999]++;
+    EXPECT_FALSE(Ranges::equal(src.begin(), src.end(), dst.begin(), dst.end()));
+    EXPECT_FALSE(Ranges::equal(src.begin(), src.end(), dst.begin(), dst.end() - 1));
+    EXPECT_TRUE(Ranges::equal(src.begin(), src.begin(), dst.begin(), dst.begin()));
+
+    //overlapping ranges and fallbacks for other iterators and types
+    Ranges::copy(src.begin() + 1, src.end(), src.begin());
+    EXPECT_EQ(src[0], 7);
+    EXPECT_EQ(src[998], 999 * 7);
+
+    std::list<std::uint32_t> list (src.begin(), src.begin() + 10);
+    EXPECT_TRUE(Ranges::equal(list.begin(), list.end(), src.begin(), src.begin() + 10));
+
+    Container::Vector<double> zeros {0.0, -0.0};
+    Container::Vector<double> same {-0.0, 0.0};
+    EXPECT_TRUE(Ranges::equal(zeros.begin(), zeros.end(), same.begin(), same.end()));
+
+    Container::Vector<std::string> strings {"a", "b"}, copies (2);
+    Ranges::copy(strings.begin(), strings.end(), copies.begin());
+    EXPECT_TRUE(Ranges::equal(strings.begin(), strings.end(), copies.begin(), copies.end()));
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "inplace_vector.hpp"
+
+namespace
+{
+
+//lookup table computed by a Vector at compile time and baked into the binary
+constexpr auto squares = []
+{
+    Container::Vector<std::uint32_t> vec {};
+    for (std::uint32_t i = 0; i < 16; i++)
+        vec.push_back(i * i);
+    std::array<std::uint32_t, 16> table {};
+    std::copy(vec.begin(), vec.end(), table.begin());
+    return table;
+}();
+static_assert(squares[15] == 225);
+
+constexpr bool vector_in_constant_evaluation()
+{
+    Container::Vector<int> vec {3, 1, 2};
+    vec.insert(vec.begin(), 0);
+    vec.insert(vec.begin() + 2, 3, 7);
+    vec.erase(vec.begin() + 1);
+    vec.resize(8, 9);
+    vec.resize_for_overwrite(9);
+    vec[8] = 5;
+    vec.shrink_to_fit();
+    Container::Vector<int> copy (vec);
+    copy.swap_remove(copy.begin());
+    //0 7 7 7 1 2 9 9 5 and the same with 5 in front
+    if (vec.size() != 9 || vec[1] != 7 || vec[4] != 1 || vec.back() != 5 || copy.front() != 5)
+        return false;
+
+    Container::Vector<std::string> strings {};
+    for (int i = 0; i < 20; i++)
+        strings.emplace_back(static_cast<std::size_t>(i), 'x');
+    strings.erase(strings.begin(), strings.begin() + 10);
+    strings.insert(strings.begin(), "front");
+    return strings.size() == 11 && strings[0] == "front" && strings[1].size() == 10;
+}
+static_assert(vector_in_constant_evaluation());
+
+constexpr bool inplace_in_constant_evaluation()
+{
+    Container::InplaceVector<std::string, 8> vec {};
+    vec.push_back("a");
+    vec.emplace_back(3, 'b');
+    vec.insert(vec.begin(), "c");
+    auto moved = std::move(vec);
+    Container::InplaceVector<std::string, 8> other {"d"};
+    other.swap(moved);
+    return other.size() == 3 && other[0] == "c" && other[2] == "bbb" && moved[0] == "d" && vec.empty();
+}
+static_assert(inplace_in_constant_evaluation());
+
+struct Counted
+{
+    static inline int alive;
+    static inline int throw_countdown;
+
+    Counted()
+    {
+        if (--throw_countdown == 0)
+            throw std::runtime_error{"countdown"};
+        alive++;
+    }
+    Counted(const Counted&): Counted() {}
+    ~Counted() {alive--;}
+};
+
+} // namespace
+
+TEST(InplaceVector, fixedCapacity)
+{
+    Container::InplaceVector<std::uint64_t, 4> vec {1, 2, 3};
+    EXPECT_EQ(vec.capacity(), 4);
+    //the elements are inside the object
+    auto obj = reinterpret_cast<const std::byte*>(&vec);
+    auto data = reinterpret_cast<const std::byte*>(vec.data());
+    EXPECT_TRUE(data >= obj && data < obj + sizeof(vec));
+
+    vec.push_back(4);
+    EXPECT_THROW(vec.push_back(5), std::length_error);
+    EXPECT_THROW(vec.insert(vec.begin(), 0), std::length_error);
+    EXPECT_THROW(vec.resize(5), std::length_error);
+    EXPECT_THROW(vec.reserve(5), std::length_error);
+    EXPECT_THROW((Container::InplaceVector<std::uint64_t, 4>(5)), std::length_error);
+    EXPECT_EQ(vec.size(), 4);
+    EXPECT_EQ(vec.back(), 4);
+
+    vec.erase(vec.begin());
+    vec.insert(vec.begin() + 1, 9);
+    EXPECT_EQ(vec[1], 9);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 4);
+
+    auto copy = vec;
+    copy.clear();
+    copy = vec;
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), vec.begin(), vec.end()));
+}
+
+TEST(InplaceVector, elementLifetimes)
+{
+    Counted::alive = 0;
+    Counted::throw_countdown = 0;
+    {
+        Container::InplaceVector<std::unique_ptr<int>, 8> ptrs {};
+        for (int i = 0; i < 5; i++)
+            ptrs.push_back(std::make_unique<int>(i));
+        Container::InplaceVector<std::unique_ptr<int>, 8> moved (std::move(ptrs));
+        EXPECT_EQ(*moved[4], 4);
+        EXPECT_TRUE(ptrs.empty());
+
+        Container::InplaceVector<Counted, 8> vec (3);
+        Container::InplaceVector<Counted, 8> other (6);
+        EXPECT_EQ(Counted::alive, 9);
+        vec.swap(other);
+        EXPECT_EQ(vec.size(), 6);
+        EXPECT_EQ(other.size(), 3);
+        EXPECT_EQ(Counted::alive, 9);
+
+        Counted::throw_countdown = 2;
+        EXPECT_THROW(vec.resize(8), std::runtime_error);
+        EXPECT_EQ(vec.size(), 6);
+        EXPECT_EQ(Counted::alive, 9);
+        Counted::throw_countdown = 0;
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
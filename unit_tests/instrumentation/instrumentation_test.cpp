@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "vector.hpp"
+#include "remap_allocator.hpp"
+
+//built with VECTOR_INSTRUMENTATION, as a separate executable
+static_assert(Container::Instrumentation::enabled);
+
+namespace
+{
+
+namespace Instr = Container::Instrumentation;
+
+struct CopyOnly
+{
+    int val = 0;
+    CopyOnly() = default;
+    CopyOnly(int v): val {v} {}
+    CopyOnly(const CopyOnly&) = default;
+    CopyOnly& operator=(const CopyOnly&) = default;
+    //throwing move, so relocation falls back to copies
+    CopyOnly(CopyOnly&& rhs) noexcept(false): val {rhs.val} {}
+    ~CopyOnly() {}
+};
+
+} // namespace
+
+TEST(Instrumentation, trivial)
+{
+    Instr::reset();
+    Container::Vector<std::uint32_t> vec;
+    vec.reserve(4);
+    for (std::uint32_t i = 0; i < 4; i++)
+        vec.push_back(i);
+    vec.push_back(4);
+    vec.resize(100);
+    vec.resize(10);
+    vec.shrink_to_fit();
+
+    auto snap = Instr::snapshot<std::uint32_t>();
+    EXPECT_EQ(snap.allocations, 4);
+    EXPECT_EQ(snap.reserve_reallocations, 1);
+    EXPECT_EQ(snap.growth_reallocations, 1);
+    EXPECT_EQ(snap.resize_reallocations, 1);
+    EXPECT_EQ(snap.shrink_reallocations, 1);
+    EXPECT_EQ(snap.elements_relocated_bitwise, 4 + 5 + 10);
+    EXPECT_EQ(snap.bytes_relocated, (4 + 5 + 10) * sizeof(std::uint32_t));
+    EXPECT_EQ(snap.elements_moved, 0);
+    EXPECT_EQ(snap.elements_copied, 0);
+    EXPECT_EQ(snap.peak_capacity, 100);
+}
+
+TEST(Instrumentation, moveAndCopyFallback)
+{
+    Instr::reset();
+    Container::Vector<std::string> strings (3, "str");
+    strings.push_back("abc");
+    Container::Vector<CopyOnly> copies (3, 1);
+    copies.emplace_back(2);
+
+    EXPECT_EQ(Instr::snapshot<std::string>().elements_moved, 3);
+    EXPECT_EQ(Instr::snapshot<std::string>().elements_copied, 0);
+    EXPECT_EQ(Instr::snapshot<CopyOnly>().elements_copied, 3);
+    EXPECT_EQ(Instr::snapshot<CopyOnly>().elements_moved, 0);
+    EXPECT_EQ(Instr::snapshot<CopyOnly>().growth_reallocations, 1);
+}
+
+TEST(Instrumentation, reallocate)
+{
+    Instr::reset();
+    Container::Vector<double, Container::RemapAllocator<double>> vec;
+    vec.reserve(10);
+    vec.reserve(1000);
+    auto snap = Instr::snapshot<double>();
+    EXPECT_EQ(snap.allocations, 2);
+    EXPECT_EQ(snap.reserve_reallocations, 2);
+    EXPECT_EQ(snap.bytes_relocated, 0);
+    EXPECT_EQ(snap.peak_capacity, 1000);
+}
+
+namespace Container::Instrumentation
+{
+template<>
+struct type_tag<long>
+{
+    static std::string name() {return "hot path";}
+};
+} // namespace Container::Instrumentation
+
+TEST(Instrumentation, dump)
+{
+    Instr::reset();
+    Container::Vector<long> vec (5);
+    std::ostringstream os;
+    Instr::dump(os);
+    auto out = os.str();
+    EXPECT_NE(out.find("hot path: allocations=1"), std::string::npos);
+    EXPECT_NE(out.find("peak_capacity=5"), std::string::npos);
+    EXPECT_EQ(Instr::snapshot("unused").allocations, 0);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
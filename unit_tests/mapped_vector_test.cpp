@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include "mapped_vector.hpp"
+
+namespace
+{
+
+struct TempFile
+{
+    std::filesystem::path path;
+
+    TempFile(const std::string& name)
+    :path {std::filesystem::temp_directory_path() / (name + "." + std::to_string(::getpid()))}
+    {}
+
+    ~TempFile() {std::filesystem::remove(path);}
+};
+
+struct Point
+{
+    std::int32_t x, y;
+};
+
+} // namespace
+
+TEST(MappedVector, persist)
+{
+    TempFile file {"mapped_vector_persist"};
+    using Vec = Container::MappedVector<std::uint64_t>;
+    {
+        Vec vec {file.path, Vec::open_mode::create};
+        EXPECT_TRUE(vec.empty());
+        for (std::uint64_t i = 0; i < 10000; i++)
+            vec.push_back(i);
+        EXPECT_GE(vec.capacity(), 10000);
+        vec.flush();
+    }
+
+    Vec vec {file.path, Vec::open_mode::read_only};
+    EXPECT_TRUE(vec.read_only());
+    ASSERT_EQ(vec.size(), 10000);
+    std::uint64_t expected = 0;
+    for (auto val : vec)
+        EXPECT_EQ(val, expected++);
+    EXPECT_THROW(vec.push_back(1), std::logic_error);
+    EXPECT_THROW(vec.reserve(100000), std::logic_error);
+}
+
+TEST(MappedVector, reopenAndGrow)
+{
+    TempFile file {"mapped_vector_grow"};
+    using Vec = Container::MappedVector<Point>;
+    {
+        Vec vec {file.path, Vec::open_mode::create};
+        vec.resize(3, Point{1, 2});
+        vec.emplace_back(Point{3, 4});
+    }
+    {
+        Vec vec {file.path};
+        ASSERT_EQ(vec.size(), 4);
+        EXPECT_EQ(vec.back().x, 3);
+        vec.push_back(vec.front());
+        vec.resize(1000);
+        EXPECT_EQ(vec[4].y, 2);
+        EXPECT_EQ(vec[999].x, 0);
+        vec.resize(100000, vec[3]);
+        EXPECT_EQ(vec[99999].x, 3);
+        EXPECT_EQ(vec[99999].y, 4);
+        vec.resize(6);
+        vec.shrink_to_fit();
+        EXPECT_EQ(vec.capacity(), 6);
+        vec.pop_back();
+    }
+    EXPECT_EQ(std::filesystem::file_size(file.path), 64 + 6 * sizeof(Point));
+
+    Vec vec {file.path, Vec::open_mode::read_only};
+    EXPECT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec.capacity(), 6);
+
+    Vec moved = std::move(vec);
+    EXPECT_EQ(moved[0].y, 2);
+
+    //the moved-from vector maps nothing
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_EQ(vec.begin(), vec.end());
+    EXPECT_THROW(vec.at(0), std::out_of_range);
+    EXPECT_THROW(vec.push_back(Point{}), std::logic_error);
+    vec.flush();
+    vec = std::move(moved);
+    EXPECT_EQ(vec.size(), 5);
+}
+
+TEST(MappedVector, errors)
+{
+    TempFile file {"mapped_vector_errors"};
+    using Vec = Container::MappedVector<std::uint64_t>;
+    EXPECT_THROW(Vec(file.path), std::system_error);
+    {
+        Vec vec {file.path, Vec::open_mode::create};
+        vec.push_back(1);
+        EXPECT_THROW(vec.at(1), std::out_of_range);
+    }
+    EXPECT_THROW(Container::MappedVector<std::uint32_t>(file.path), std::runtime_error);
+
+    std::filesystem::resize_file(file.path, 10);
+    EXPECT_THROW(Vec(file.path), std::runtime_error);
+}
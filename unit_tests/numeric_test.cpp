@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include "numeric.hpp"
+
+namespace
+{
+
+using Container::Numeric::Isa;
+
+constexpr Isa isas[] = {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512};
+
+template<typename T>
+bool equal(const Container::Vector<T>& vec, std::initializer_list<T> expected)
+{
+    return std::equal(vec.begin(), vec.end(), expected.begin(), expected.end());
+}
+
+} // namespace
+
+TEST(Numeric, expressions)
+{
+    Container::Vector<double> a {1, 2, 3, 4}, b {10, 20, 30, 40}, c {2, 2, 2, 2};
+    Container::Vector<double> result;
+
+    Container::Numeric::assign(result, a * c + b);
+    EXPECT_TRUE(equal<double>(result, {12, 24, 36, 48}));
+
+    Container::Numeric::assign(result, (b - a) / 2.0 - -a);
+    EXPECT_TRUE(equal<double>(result, {5.5, 11, 16.5, 22}));
+
+    auto evaluated = Container::Numeric::eval(2 * a + 1);
+    EXPECT_TRUE(equal<double>(evaluated, {3, 5, 7, 9}));
+
+    //the destination may be an operand
+    Container::Numeric::assign(a, a * a);
+    EXPECT_TRUE(equal<double>(a, {1, 4, 9, 16}));
+
+    a += b * c;
+    EXPECT_TRUE(equal<double>(a, {21, 44, 69, 96}));
+    a -= 1;
+    a /= c;
+    EXPECT_TRUE(equal<double>(a, {10, 21.5, 34, 47.5}));
+
+    EXPECT_EQ(Container::Numeric::sum(a - b), 13);
+
+    Container::Vector<double> shorter {1, 2};
+    EXPECT_THROW(a + shorter, std::invalid_argument);
+    EXPECT_THROW(a += shorter, std::invalid_argument);
+
+    Container::Vector<std::int32_t> ints {1, 2, 3};
+    Container::Vector<std::int32_t> squares;
+    Container::Numeric::assign(squares, ints * ints);
+    EXPECT_TRUE(equal<std::int32_t>(squares, {1, 4, 9}));
+}
+
+TEST(Numeric, reductions)
+{
+    //sizes around every vector width and unroll boundary
+    for (std::size_t n : {1, 3, 7, 15, 16, 17, 31, 33, 64, 65, 127, 1000})
+    {
+        Container::Vector<float> floats (n);
+        Container::Vector<double> doubles (n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            //small integers, so every summation order is exact
+            floats[i] = static_cast<float>((i * 37) % 101) - 50;
+            doubles[i] = static_cast<double>((i * 53) % 97) - 48;
+        }
+        auto fsum = std::accumulate(floats.begin(), floats.end(), 0.0f);
+        auto fdot = std::inner_product(floats.begin(), floats.end(), floats.begin(), 0.0f);
+        auto fmin = *std::min_element(floats.begin(), floats.end());
+        auto dmax = *std::max_element(doubles.begin(), doubles.end());
+
+        EXPECT_EQ(Container::Numeric::sum(floats), fsum);
+        EXPECT_EQ(Container::Numeric::dot(floats, floats), fdot);
+        EXPECT_EQ(Container::Numeric::min(floats), fmin);
+        EXPECT_EQ(Container::Numeric::max(doubles), dmax);
+
+        for (auto isa : isas)
+        {
+            if (!Container::Numeric::supported(isa))
+                continue;
+            auto& fk = Container::Numeric::kernels<float>(isa);
+            EXPECT_EQ(fk.sum(floats.data(), n), fsum);
+            EXPECT_EQ(fk.dot(floats.data(), floats.data(), n), fdot);
+            EXPECT_EQ(fk.min(floats.data(), n), fmin);
+            EXPECT_EQ(fk.max(floats.data(), n), *std::max_element(floats.begin(), floats.end()));
+
+            auto& dk = Container::Numeric::kernels<double>(isa);
+            EXPECT_EQ(dk.sum(doubles.data(), n), std::accumulate(doubles.begin(), doubles.end(), 0.0));
+            EXPECT_EQ(dk.min(doubles.data(), n), *std::min_element(doubles.begin(), doubles.end()));
+            EXPECT_EQ(dk.max(doubles.data(), n), dmax);
+        }
+    }
+
+    Container::Vector<std::int64_t> ints {5, -3, 8};
+    EXPECT_EQ(Container::Numeric::sum(ints), 10);
+    EXPECT_EQ(Container::Numeric::dot(ints, ints), 98);
+    EXPECT_EQ(Container::Numeric::min(ints), -3);
+    EXPECT_EQ(Container::Numeric::max(ints), 8);
+
+    Container::Vector<double> empty;
+    EXPECT_EQ(Container::Numeric::sum(empty), 0);
+    EXPECT_THROW(Container::Numeric::min(empty), std::underflow_error);
+    EXPECT_THROW(Container::Numeric::max(empty), std::underflow_error);
+    EXPECT_THROW(Container::Numeric::dot(empty, Container::Vector<double>(1)), std::invalid_argument);
+}
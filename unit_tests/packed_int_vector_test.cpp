@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "packed_int_vector.hpp"
+
+namespace
+{
+
+template<typename T>
+std::vector<T> random_values(std::size_t size, T lo, T hi, unsigned seed)
+{
+    std::mt19937_64 gen {seed};
+    std::uniform_int_distribution<T> dist {lo, hi};
+    std::vector<T> values (size);
+    for (auto& val : values)
+        val = dist(gen);
+    return values;
+}
+
+template<typename T>
+void expect_same(const Container::PackedIntVector<T>& packed, const std::vector<T>& expected)
+{
+    ASSERT_EQ(packed.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); i++)
+        ASSERT_EQ(packed[i], expected[i]) << i;
+    EXPECT_TRUE(std::equal(packed.begin(), packed.end(), expected.begin(), expected.end()));
+}
+
+} // namespace
+
+TEST(PackedIntVector, randomAccess)
+{
+    Container::PackedIntVector<std::uint64_t> packed;
+    std::vector<std::uint64_t> expected;
+    std::mt19937_64 gen {1};
+    //blocks of every width, including constant blocks and full 64-bit ones
+    for (unsigned width = 0; width <= 64; width++)
+        for (std::size_t i = 0; i < Container::PackedIntVector<>::block_size; i++)
+        {
+            auto val = 1000 + (width ? gen() & Container::detail::low_bits(width) : 0);
+            if (width == 64)
+                val = gen();
+            packed.push_back(val);
+            expected.push_back(val);
+        }
+    for (int i = 0; i < 50; i++)
+    {
+        packed.push_back(i);
+        expected.push_back(i);
+    }
+    expect_same(packed, expected);
+    EXPECT_EQ(packed.width_at(0), 0);
+    EXPECT_EQ(packed.width_at(128 * 20), 20);
+    EXPECT_EQ(packed.back(), 49);
+    EXPECT_THROW(packed.at(expected.size()), std::out_of_range);
+    EXPECT_THROW(Container::PackedIntVector<int>{}.front(), std::underflow_error);
+}
+
+TEST(PackedIntVector, signedAndNarrowTypes)
+{
+    auto values = random_values<std::int64_t>(10000, -5000, 5000, 2);
+    values[300] = std::numeric_limits<std::int64_t>::min();
+    values[301] = std::numeric_limits<std::int64_t>::max();
+    Container::PackedIntVector<std::int64_t> packed {values};
+    expect_same(packed, values);
+
+    auto narrow = random_values<std::int16_t>(1000, -100, 100, 3);
+    Container::PackedIntVector<std::int16_t> packed_narrow {narrow};
+    expect_same(packed_narrow, narrow);
+    auto decoded = packed_narrow.to_vector();
+    EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), narrow.begin(), narrow.end()));
+}
+
+TEST(PackedIntVector, decode)
+{
+    auto values = random_values<std::uint64_t>(5000, 1 << 20, (1 << 20) + 50000, 4);
+    Container::PackedIntVector<std::uint64_t> packed {values};
+    packed.shrink_to_fit();
+    EXPECT_LT(packed.memory_bytes(), values.size() * sizeof(std::uint64_t) / 3);
+
+    for (auto [first, count] : {std::pair<std::size_t, std::size_t>{0, 5000}, {0, 0}, {1, 7}, {120, 20}, {4990, 10},
+                                {4000, 900}, {127, 1}})
+    {
+        std::vector<std::uint64_t> out (count);
+        packed.decode(first, out);
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), values.begin() + first)) << first << " " << count;
+    }
+    std::vector<std::uint64_t> out (2);
+    EXPECT_THROW(packed.decode(4999, out), std::out_of_range);
+
+    using Container::Numeric::Isa;
+    for (auto isa : {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512})
+    {
+        if (!Container::Numeric::supported(isa))
+        {
+            EXPECT_THROW(Container::unpack_kernel(isa), std::invalid_argument);
+            continue;
+        }
+        auto kernel = Container::unpack_kernel(isa);
+        for (unsigned width : {0u, 1u, 7u, 13u, 32u, 63u, 64u})
+        {
+            std::vector<std::uint64_t> raw (128);
+            for (std::size_t i = 0; i < raw.size(); i++)
+                raw[i] = (i * 0x9e3779b97f4a7c15) & Container::detail::low_bits(width);
+            Container::PackedIntVector<std::uint64_t> block {raw};
+            block.push_back(0);
+            std::vector<std::uint64_t> unpacked (128);
+            block.decode(0, unpacked);
+            EXPECT_EQ(unpacked, raw) << width;
+
+            //the kernel on its own, from an unaligned start
+            std::vector<std::uint64_t> direct (100), reference (100);
+            std::vector<std::uint64_t> packed_words (2 * width + 1);
+            for (std::size_t i = 0; i < raw.size(); i++)
+                for (unsigned bit = 0; bit < width; bit++)
+                    if (raw[i] >> bit & 1)
+                        packed_words[(i * width + bit) / 64] |= std::uint64_t{1} << ((i * width + bit) % 64);
+            kernel(packed_words.data(), width, 5, 11, 100, direct.data());
+            Container::detail::scalar_unpack(packed_words.data(), width, 5, 11, 100, reference.data());
+            EXPECT_EQ(direct, reference) << width;
+            for (std::size_t i = 0; i < 100; i++)
+                ASSERT_EQ(direct[i], raw[11 + i] + 5);
+        }
+    }
+}
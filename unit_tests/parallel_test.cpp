@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "vector.hpp"
+#include "parallel_ranges.hpp"
+
+namespace
+{
+
+struct Counted
+{
+    static inline std::atomic<int> alive;
+    static inline std::atomic<int> throw_countdown;
+    std::uint64_t val;
+
+    Counted(std::uint64_t v = 0): val {v}
+    {
+        if (throw_countdown.fetch_sub(1) == 1)
+            throw std::runtime_error{"countdown"};
+        alive++;
+    }
+    Counted(const Counted& rhs): Counted(rhs.val) {}
+    ~Counted() {alive--;}
+};
+
+//tiny grain, so even small ranges are split
+Container::ThreadPool pool {3};
+const Container::parallel_policy policy {&pool, 64};
+
+} // namespace
+
+TEST(Parallel, threadPool)
+{
+    std::atomic<std::uint64_t> sum {0};
+    pool.run(1000, [&sum](std::size_t i){sum += i;});
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+
+    //nested batches finish even when every worker is busy
+    std::atomic<int> calls {0};
+    pool.run(8, [&calls](std::size_t){pool.run(8, [&calls](std::size_t){calls++;});});
+    EXPECT_EQ(calls, 64);
+}
+
+TEST(Parallel, construct)
+{
+    Container::Vector<std::uint64_t> filled (policy, 100000, 7);
+    EXPECT_EQ(filled.size(), 100000);
+    EXPECT_EQ(std::count(filled.begin(), filled.end(), 7), 100000);
+
+    Container::Vector<std::uint64_t> zeros (policy, 100000);
+    EXPECT_EQ(std::count(zeros.begin(), zeros.end(), 0), 100000);
+
+    for (std::uint64_t i = 0; i < filled.size(); i++)
+        filled[i] = i;
+    Container::Vector<std::uint64_t> copy (policy, filled);
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), filled.begin(), filled.end()));
+
+    Container::Vector<std::string> strings (policy, 5000, "str");
+    Container::Vector<std::string> from_range (policy, strings.begin(), strings.end());
+    EXPECT_EQ(from_range.size(), 5000);
+    EXPECT_EQ(from_range[4999], "str");
+
+    copy.resize(policy, 300000, 1);
+    EXPECT_EQ(copy[99999], 99999);
+    EXPECT_EQ(copy[299999], 1);
+    copy.resize(policy, 10);
+    EXPECT_EQ(copy.size(), 10);
+
+    Container::Vector<int> dflt (Container::par, 1000, 3);
+    EXPECT_EQ(dflt[999], 3);
+}
+
+TEST(Parallel, exceptions)
+{
+    Counted::alive = 0;
+    Counted::throw_countdown = 0;
+    Container::Vector<Counted> vec (policy, 1000);
+
+    for (int countdown : {1, 500, 1500})
+    {
+        Counted::throw_countdown = countdown;
+        EXPECT_THROW(Container::Vector<Counted> (policy, 2000, Counted{0}), std::runtime_error);
+        EXPECT_EQ(Counted::alive, 1000);
+
+        Counted::throw_countdown = countdown;
+        EXPECT_THROW(vec.resize(policy, 5000), std::runtime_error);
+        EXPECT_EQ(vec.size(), 1000);
+        EXPECT_EQ(Counted::alive, 1000);
+    }
+    Counted::throw_countdown = 0;
+    vec.clear();
+    EXPECT_EQ(Counted::alive, 0);
+}
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "persistent_vector.hpp"
+
+namespace
+{
+
+using Container::PersistentVector;
+
+template<typename T>
+bool equal(const PersistentVector<T>& vec, const std::vector<T>& expected)
+{
+    if (vec.size() != expected.size())
+        return false;
+    for (std::size_t i = 0; i < expected.size(); i++)
+        if (vec[i] != expected[i])
+            return false;
+    return std::equal(vec.begin(), vec.end(), expected.begin(), expected.end());
+}
+
+PersistentVector<int> iota(int first, int last)
+{
+    auto builder = PersistentVector<int>{}.transient();
+    for (int i = first; i < last; i++)
+        builder.push_back(i);
+    return builder.persistent();
+}
+
+std::vector<int> iota_std(int first, int last)
+{
+    std::vector<int> vec (last - first);
+    std::iota(vec.begin(), vec.end(), first);
+    return vec;
+}
+
+} // namespace
+
+TEST(PersistentVector, versionsAreIndependent)
+{
+    PersistentVector<std::string> first {"a", "b", "c"};
+    auto second = first.push_back("d");
+    auto third = second.set(0, "z");
+
+    EXPECT_TRUE(equal(first, {"a", "b", "c"}));
+    EXPECT_TRUE(equal(second, {"a", "b", "c", "d"}));
+    EXPECT_TRUE(equal(third, {"z", "b", "c", "d"}));
+    EXPECT_TRUE(equal(third.pop_back(), {"z", "b", "c"}));
+
+    EXPECT_THROW(first.at(3), std::out_of_range);
+    EXPECT_THROW((void)first.set(3, "x"), std::out_of_range);
+    EXPECT_THROW((void)PersistentVector<int>{}.pop_back(), std::underflow_error);
+    EXPECT_THROW(PersistentVector<int>{}.front(), std::underflow_error);
+}
+
+TEST(PersistentVector, deepTrees)
+{
+    constexpr int n = 40000;
+    PersistentVector<int> vec;
+    std::vector<PersistentVector<int>> versions;
+    for (int i = 0; i < n; i++)
+    {
+        vec = vec.push_back(i);
+        if (i % 5000 == 0)
+            versions.push_back(vec);
+    }
+    EXPECT_TRUE(equal(vec, iota_std(0, n)));
+    for (std::size_t v = 0; v < versions.size(); v++)
+        EXPECT_TRUE(equal(versions[v], iota_std(0, static_cast<int>(v * 5000 + 1))));
+
+    auto changed = vec.set(12345, -1).set(n - 1, -2).set(0, -3);
+    EXPECT_EQ(changed[12345], -1);
+    EXPECT_EQ(changed.back(), -2);
+    EXPECT_EQ(changed.front(), -3);
+    EXPECT_EQ(vec[12345], 12345);
+
+    for (int i = 0; i < n - 100; i++)
+        vec = vec.pop_back();
+    EXPECT_TRUE(equal(vec, iota_std(0, 100)));
+}
+
+TEST(PersistentVector, slice)
+{
+    constexpr int n = 5000;
+    auto vec = iota(0, n);
+    for (auto [first, last] : {std::pair{0, n}, {0, 0}, {1, n}, {0, 1}, {31, 33}, {32, 64}, {1000, 1033},
+                               {1023, 1025}, {4990, 5000}, {100, 4900}, {2500, 2500}})
+    {
+        auto sliced = vec.slice(first, last);
+        EXPECT_TRUE(equal(sliced, iota_std(first, last))) << first << " " << last;
+        EXPECT_TRUE(equal(sliced.push_back(-1).pop_back(), iota_std(first, last)));
+    }
+    EXPECT_THROW((void)vec.slice(10, 5), std::out_of_range);
+    EXPECT_THROW((void)vec.slice(0, n + 1), std::out_of_range);
+    EXPECT_TRUE(equal(vec, iota_std(0, n)));
+
+    //relaxed trees keep working under further modifications
+    auto sliced = vec.drop(7).take(3000);
+    for (int i = 0; i < 1000; i++)
+        sliced = sliced.push_back(i);
+    auto expected = iota_std(7, 3007);
+    auto tail = iota_std(0, 1000);
+    expected.insert(expected.end(), tail.begin(), tail.end());
+    EXPECT_TRUE(equal(sliced, expected));
+    EXPECT_EQ(sliced.set(1500, -1)[1500], -1);
+}
+
+TEST(PersistentVector, concat)
+{
+    for (int lsize : {0, 1, 31, 32, 33, 100, 1024, 1057, 5000})
+        for (int rsize : {0, 1, 32, 33, 999, 1024, 4000})
+        {
+            auto lhs = iota(0, lsize), rhs = iota(lsize, lsize + rsize);
+            auto both = lhs.concat(rhs);
+            EXPECT_TRUE(equal(both, iota_std(0, lsize + rsize))) << lsize << " " << rsize;
+            EXPECT_TRUE(equal(lhs, iota_std(0, lsize)));
+            EXPECT_TRUE(equal(rhs, iota_std(lsize, lsize + rsize)));
+        }
+}
+
+TEST(PersistentVector, randomOperations)
+{
+    std::mt19937 gen {42};
+    PersistentVector<int> vec;
+    std::vector<int> expected;
+    for (int step = 0; step < 3000; step++)
+    {
+        auto size = static_cast<int>(expected.size());
+        switch (gen() % 6)
+        {
+        case 0:
+        case 1:
+        {
+            auto count = static_cast<int>(gen() % 200);
+            auto extra = iota(step * 1000, step * 1000 + count);
+            auto std_extra = iota_std(step * 1000, step * 1000 + count);
+            if (gen() % 2)
+            {
+                vec = vec.concat(extra);
+                expected.insert(expected.end(), std_extra.begin(), std_extra.end());
+            }
+            else
+            {
+                vec = extra.concat(vec);
+                expected.insert(expected.begin(), std_extra.begin(), std_extra.end());
+            }
+            break;
+        }
+        case 2:
+        {
+            auto first = size ? static_cast<int>(gen() % size) : 0;
+            auto last = first + (size - first ? static_cast<int>(gen() % (size - first + 1)) : 0);
+            if (expected.size() < 3000)
+                break;
+            vec = vec.slice(first, last);
+            expected = std::vector<int>(expected.begin() + first, expected.begin() + last);
+            break;
+        }
+        case 3:
+            if (size)
+            {
+                auto index = gen() % size;
+                vec = vec.set(index, -step);
+                expected[index] = -step;
+            }
+            break;
+        case 4:
+            vec = vec.push_back(step);
+            expected.push_back(step);
+            break;
+        case 5:
+            if (size)
+            {
+                vec = vec.pop_back();
+                expected.pop_back();
+            }
+            break;
+        }
+        ASSERT_TRUE(equal(vec, expected)) << step;
+    }
+}
+
+TEST(PersistentVector, transient)
+{
+    auto base = iota(0, 1000);
+    auto builder = base.transient();
+    for (int i = 0; i < 1000; i++)
+        builder.set(i, builder[i] * 2);
+    builder.push_back(-1);
+    auto snapshot = builder.persistent();
+    builder.pop_back();
+    builder.append(base);
+    builder.take(1500);
+    builder.drop(10);
+
+    EXPECT_TRUE(equal(base, iota_std(0, 1000)));
+    EXPECT_EQ(snapshot.size(), 1001);
+    EXPECT_EQ(snapshot[999], 1998);
+    EXPECT_EQ(snapshot.back(), -1);
+    EXPECT_EQ(builder.size(), 1490);
+    EXPECT_EQ(builder[0], 20);
+    EXPECT_EQ(builder[990], 0);
+    EXPECT_EQ(builder.at(1489), 499);
+}
+
+TEST(PersistentVector, vectorConversions)
+{
+    Container::Vector<std::string> vec;
+    for (int i = 0; i < 777; i++)
+        vec.push_back(std::to_string(i));
+
+    PersistentVector<std::string> persistent {vec};
+    ASSERT_EQ(persistent.size(), vec.size());
+    EXPECT_TRUE(std::equal(persistent.begin(), persistent.end(), vec.begin(), vec.end()));
+
+    auto back = persistent.set(5, "five").to_vector();
+    EXPECT_EQ(back.size(), 777);
+    EXPECT_EQ(back[5], "five");
+    EXPECT_EQ(back[776], "776");
+    EXPECT_TRUE(std::equal(persistent.rbegin(), persistent.rend(), vec.rbegin(), vec.rend()));
+}
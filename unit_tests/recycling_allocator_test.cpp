@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "recycling_allocator.hpp"
+#include "vector.hpp"
+
+namespace
+{
+
+using Container::BufferPool;
+
+struct PoolTest: ::testing::Test
+{
+    BufferPool& pool = *BufferPool::local();
+
+    void SetUp() override
+    {
+        pool.set_limit(BufferPool::default_limit);
+        pool.trim();
+        pool.reset_stats();
+    }
+
+    void TearDown() override
+    {
+        pool.set_limit(BufferPool::default_limit);
+        pool.trim();
+    }
+};
+
+} // namespace
+
+TEST_F(PoolTest, sizeClasses)
+{
+    EXPECT_EQ(BufferPool::block_size(1), 64);
+    EXPECT_EQ(BufferPool::block_size(64), 64);
+    EXPECT_EQ(BufferPool::block_size(65), 128);
+    EXPECT_EQ(BufferPool::block_size(5000), 8192);
+    EXPECT_EQ(BufferPool::block_size(BufferPool::max_block_size), BufferPool::max_block_size);
+    EXPECT_EQ(BufferPool::block_size(BufferPool::max_block_size + 1), BufferPool::max_block_size + 1);
+}
+
+TEST_F(PoolTest, reusesFreedBlocks)
+{
+    auto first = pool.allocate(1000);
+    pool.deallocate(first, 1000);
+    EXPECT_EQ(pool.stats().cached_bytes, 1024);
+
+    //any size of the class gets the block back
+    auto second = pool.allocate(600);
+    EXPECT_EQ(second, first);
+    auto third = pool.allocate(600);
+    EXPECT_NE(third, first);
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.recycled, 1);
+    EXPECT_EQ(stats.cached_bytes, 0);
+
+    pool.deallocate(second, 600);
+    pool.deallocate(third, 600);
+
+    //too big to cache
+    auto huge = pool.allocate(BufferPool::max_block_size + 1);
+    pool.deallocate(huge, BufferPool::max_block_size + 1);
+    EXPECT_EQ(pool.stats().released, 1);
+    EXPECT_EQ(pool.stats().cached_bytes, 2048);
+}
+
+TEST_F(PoolTest, boundedAndTrimmed)
+{
+    pool.set_limit(4096);
+    void* blocks[8];
+    for (auto& block : blocks)
+        block = pool.allocate(1024);
+    for (auto block : blocks)
+        pool.deallocate(block, 1024);
+    EXPECT_EQ(pool.stats().cached_bytes, 4096);
+    EXPECT_EQ(pool.stats().recycled, 4);
+    EXPECT_EQ(pool.stats().released, 4);
+
+    pool.trim(1024);
+    EXPECT_EQ(pool.stats().cached_bytes, 1024);
+    pool.set_limit(0);
+    EXPECT_EQ(pool.stats().cached_bytes, 0);
+}
+
+TEST_F(PoolTest, perThread)
+{
+    auto block = pool.allocate(256);
+    pool.deallocate(block, 256);
+
+    std::thread other {[block]
+    {
+        auto& local = *BufferPool::local();
+        EXPECT_EQ(local.stats().cached_bytes, 0);
+        auto ptr = local.allocate(256);
+        EXPECT_NE(ptr, block);
+        //freed here, so cached by this thread's pool and released when the thread exits
+        local.deallocate(ptr, 256);
+        EXPECT_EQ(local.stats().cached_bytes, 256);
+    }};
+    other.join();
+    EXPECT_EQ(pool.stats().cached_bytes, 256);
+}
+
+TEST_F(PoolTest, vectorCycles)
+{
+    using Recycled = Container::Vector<std::string, Container::RecyclingAllocator<std::string>,
+                                       Container::Growth::UsableSize<>>;
+    std::size_t first_misses = 0;
+    for (int cycle = 0; cycle < 10; cycle++)
+    {
+        Recycled vec;
+        for (int i = 0; i < 1000; i++)
+        {
+            vec.push_back(std::to_string(i));
+            EXPECT_EQ(vec.capacity() * sizeof(std::string), BufferPool::block_size(vec.capacity() * sizeof(std::string)));
+        }
+        EXPECT_EQ(vec[999], "999");
+
+        Recycled reserved;
+        reserved.reserve(1000);
+        EXPECT_GE(reserved.capacity(), 1000);
+
+        if (cycle == 0)
+            first_misses = pool.stats().misses;
+    }
+    //only the first cycle climbs the growth ladder through ::operator new
+    EXPECT_EQ(pool.stats().misses, first_misses);
+    EXPECT_EQ(pool.stats().hits, 9 * first_misses);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "segmented_vector.hpp"
+
+namespace
+{
+
+struct ThrowAt
+{
+    static inline int countdown;
+    static inline int alive;
+
+    ThrowAt()
+    {
+        if (--countdown == 0)
+            throw std::runtime_error{"countdown"};
+        alive++;
+    }
+    ThrowAt(const ThrowAt&): ThrowAt() {}
+    ~ThrowAt() {alive--;}
+};
+
+} // namespace
+
+TEST(SegmentedVector, stableReferences)
+{
+    Container::SegmentedVector<std::string, 4> vec {};
+    auto& first = vec.emplace_back("first");
+    auto first_ptr = &first;
+    for (int i = 1; i < 100; i++)
+        vec.push_back(std::to_string(i));
+    EXPECT_EQ(&vec[0], first_ptr);
+    EXPECT_EQ(vec.front(), "first");
+    EXPECT_EQ(vec.back(), "99");
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(vec.capacity(), 100);
+    EXPECT_EQ(vec.block_count(), 25);
+
+    vec.push_back(vec[0]);
+    EXPECT_EQ(vec.back(), "first");
+    EXPECT_EQ(vec.block(25).size(), 1);
+    EXPECT_EQ(vec.block(24)[3], "99");
+    EXPECT_THROW(vec.at(101), std::out_of_range);
+
+    vec.pop_back();
+    vec.resize(10);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 12);
+    EXPECT_EQ(&vec[0], first_ptr);
+}
+
+TEST(SegmentedVector, iteratorsAndBlocks)
+{
+    Container::SegmentedVector<std::uint32_t, 16> vec (100);
+    std::iota(vec.begin(), vec.end(), 0);
+    EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+    EXPECT_EQ(*std::lower_bound(vec.begin(), vec.end(), 42), 42);
+    EXPECT_EQ(vec.end() - vec.begin(), 100);
+    EXPECT_EQ(*vec.rbegin(), 99);
+
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < vec.block_count(); i++)
+        for (auto val : vec.block(i))
+            sum += val;
+    EXPECT_EQ(sum, 99 * 100 / 2);
+
+    auto copy = vec;
+    vec.resize(200, 7);
+    EXPECT_EQ(copy.size(), 100);
+    EXPECT_EQ(vec[150], 7);
+    copy = std::move(vec);
+    EXPECT_EQ(copy.size(), 200);
+    EXPECT_TRUE(vec.empty());
+
+    Container::SegmentedVector<int> list {1, 2, 3};
+    EXPECT_EQ(list[2], 3);
+}
+
+TEST(SegmentedVector, exceptions)
+{
+    ThrowAt::alive = 0;
+    ThrowAt::countdown = 0;
+    Container::SegmentedVector<ThrowAt, 4> vec (6);
+    ThrowAt::countdown = 5;
+    EXPECT_THROW(vec.resize(20), std::runtime_error);
+    EXPECT_EQ(vec.size(), 6);
+    EXPECT_EQ(ThrowAt::alive, 6);
+
+    ThrowAt::countdown = 0;
+    vec.clear();
+    EXPECT_EQ(ThrowAt::alive, 0);
+}
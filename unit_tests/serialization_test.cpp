@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "serialization.hpp"
+
+namespace
+{
+
+namespace Ser = Container::Serialization;
+
+//anonymous file that is rewound before reading
+struct Stream
+{
+    std::FILE* file = std::tmpfile();
+    int fd() const {return ::fileno(file);}
+    void rewind() const {::lseek(fd(), 0, SEEK_SET);}
+    ~Stream() {std::fclose(file);}
+};
+
+} // namespace
+
+TEST(Serialization, trivial)
+{
+    //spans several chunks
+    Container::Vector<std::uint64_t> vec {};
+    for (std::uint64_t i = 0; i < 300000; i++)
+        vec.push_back(i * i);
+    Container::Vector<std::uint64_t> empty {};
+
+    Stream stream;
+    Ser::write(stream.fd(), vec);
+    Ser::write(stream.fd(), empty);
+    EXPECT_EQ(::lseek(stream.fd(), 0, SEEK_CUR), 2 * sizeof(Ser::Header) + vec.size() * sizeof(std::uint64_t));
+    stream.rewind();
+
+    Container::Vector<std::uint64_t> loaded {1, 2, 3};
+    Ser::read(stream.fd(), loaded);
+    EXPECT_EQ(loaded.size(), vec.size());
+    EXPECT_TRUE(std::equal(loaded.begin(), loaded.end(), vec.begin()));
+    Ser::read(stream.fd(), loaded);
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST(Serialization, codec)
+{
+    Container::Vector<std::string> vec {"", "a", std::string(3000000, 'x'), "tail"};
+    Stream stream;
+    Ser::write(stream.fd(), vec, Ser::StringCodec{});
+    stream.rewind();
+
+    Container::Vector<std::string> loaded {};
+    Ser::read(stream.fd(), loaded, Ser::StringCodec{});
+    ASSERT_EQ(loaded.size(), 4);
+    EXPECT_EQ(loaded[1], "a");
+    EXPECT_EQ(loaded[2], vec[2]);
+    EXPECT_EQ(loaded[3], "tail");
+
+    stream.rewind();
+    Container::Vector<std::uint64_t> wrong {};
+    EXPECT_THROW(Ser::read(stream.fd(), wrong), std::runtime_error);
+}
+
+TEST(Serialization, corruption)
+{
+    Container::Vector<std::uint32_t> vec (1000, 7);
+    Stream stream;
+    Ser::write(stream.fd(), vec);
+
+    std::uint32_t garbage = 8;
+    ::pwrite(stream.fd(), &garbage, sizeof(garbage), sizeof(Ser::Header) + 40);
+    stream.rewind();
+    Container::Vector<std::uint32_t> loaded {};
+    EXPECT_THROW(Ser::read(stream.fd(), loaded), std::runtime_error);
+    EXPECT_TRUE(loaded.empty());
+
+    stream.rewind();
+    Container::Vector<std::int64_t> other {};
+    EXPECT_THROW(Ser::read(stream.fd(), other), std::runtime_error);
+
+    ::ftruncate(stream.fd(), sizeof(Ser::Header) + 100);
+    stream.rewind();
+    EXPECT_THROW(Ser::read(stream.fd(), loaded), std::runtime_error);
+}
+
+TEST(Serialization, hugeCount)
+{
+    //a consistent header claiming far more elements than follow must fail before it allocates them
+    Ser::Header hdr;
+    hdr.element_size = sizeof(std::uint64_t);
+    hdr.element_align = alignof(std::uint64_t);
+    hdr.count = std::uint64_t{1} << 50;
+    hdr.payload_bytes = hdr.count * sizeof(std::uint64_t);
+    std::uint64_t data[16] {};
+
+    Stream stream;
+    ::write(stream.fd(), &hdr, sizeof(hdr));
+    ::write(stream.fd(), data, sizeof(data));
+    stream.rewind();
+    Container::Vector<std::uint64_t> loaded {};
+    EXPECT_THROW(Ser::read(stream.fd(), loaded), std::runtime_error);
+    EXPECT_TRUE(loaded.empty());
+
+    //a pipe has no length, the read stops at the end of the data
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ::write(fds[1], &hdr, sizeof(hdr));
+    ::write(fds[1], data, sizeof(data));
+    ::close(fds[1]);
+    EXPECT_THROW(Ser::read(fds[0], loaded), std::runtime_error);
+    EXPECT_TRUE(loaded.empty());
+    ::close(fds[0]);
+}
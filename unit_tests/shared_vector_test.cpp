@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include "shared_vector.hpp"
+
+TEST(SharedVector, copyOnWrite)
+{
+    Container::SharedVector<std::string> first {"a", "b", "c"};
+    auto second = first;
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_EQ(first.use_count(), 2);
+
+    second.push_back("d");
+    EXPECT_NE(first.data(), second.data());
+    EXPECT_EQ(first.size(), 3);
+    EXPECT_EQ(second.size(), 4);
+    EXPECT_TRUE(first.unique());
+
+    //a unique handle modifies in place
+    auto data = second.data();
+    second.set(0, "z");
+    EXPECT_EQ(second.data(), data);
+    EXPECT_EQ(second.front(), "z");
+    EXPECT_EQ(first.front(), "a");
+
+    //arguments may refer to the elements being detached from
+    auto third = first;
+    third.push_back(third[0]);
+    third.resize(6, third[1]);
+    EXPECT_EQ(third.back(), "b");
+    EXPECT_EQ(third[3], "a");
+    EXPECT_EQ(first.size(), 3);
+
+    auto moved = std::move(third);
+    EXPECT_TRUE(third.empty());
+    third.push_back("again");
+    EXPECT_EQ(third.size(), 1);
+
+    auto cleared = moved;
+    cleared.clear();
+    EXPECT_TRUE(cleared.empty());
+    EXPECT_EQ(moved.size(), 6);
+    EXPECT_TRUE(std::equal(moved.begin(), moved.begin() + 3, first.begin(), first.end()));
+    EXPECT_EQ(moved.subspan(3, 2)[1], "b");
+}
+
+TEST(SharedVector, detachShrinking)
+{
+    Container::SharedVector<std::string> first {"a", "b", "c", "d", "e"};
+    first.reserve(100);
+
+    //only the kept elements are copied out of a shared buffer
+    auto popped = first;
+    popped.pop_back();
+    EXPECT_EQ(popped.size(), 4);
+    EXPECT_EQ(popped.capacity(), 4);
+    EXPECT_EQ(popped.back(), "d");
+    auto shrunk = first;
+    shrunk.resize(2, "unused");
+    EXPECT_EQ(shrunk.capacity(), 2);
+    EXPECT_EQ(shrunk.back(), "b");
+    EXPECT_EQ(first.size(), 5);
+
+    auto modified = first;
+    modified.modify([](auto& vec){vec.erase(vec.begin(), vec.begin() + 4);});
+    EXPECT_EQ(modified.front(), "e");
+    EXPECT_EQ(first.front(), "a");
+
+    Container::SharedVector<std::string> none;
+    auto copy = none;
+    EXPECT_THROW(copy.pop_back(), std::underflow_error);
+}
+
+TEST(SharedVector, statefulAllocator)
+{
+    using Alloc = std::pmr::polymorphic_allocator<int>;
+    std::pmr::monotonic_buffer_resource resource;
+    Container::SharedVector<int, Alloc> first {{1, 2, 3}, Alloc{&resource}};
+    auto second = std::move(first);
+    EXPECT_EQ(second.get_allocator().resource(), &resource);
+    //the moved-from handle keeps the source's allocator
+    EXPECT_TRUE(first.empty());
+    EXPECT_EQ(first.get_allocator().resource(), &resource);
+    first.push_back(4);
+    EXPECT_EQ(first.get_allocator().resource(), &resource);
+    EXPECT_EQ(second.size(), 3);
+}
+
+TEST(SharedVector, publishAndLoad)
+{
+    Container::AtomicSharedVector<std::uint64_t> table {Container::SharedVector<std::uint64_t>{0, 0, 0, 0}};
+    std::atomic<bool> done {false};
+    std::atomic<int> torn {0};
+
+    //every published version has equal elements, a reader must never see a mix
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++)
+        readers.emplace_back([&]
+        {
+            while (!done.load())
+            {
+                auto snapshot = table.load();
+                if (std::adjacent_find(snapshot.begin(), snapshot.end(), std::not_equal_to<>{}) != snapshot.end())
+                    torn++;
+            }
+        });
+
+    for (std::uint64_t version = 1; version <= 200; version++)
+    {
+        auto next = table.load();
+        for (std::size_t i = 0; i < next.size(); i++)
+            next.set(i, version);
+        table.publish(std::move(next));
+    }
+
+    //concurrent updates are all applied
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; i++)
+        writers.emplace_back([&]
+        {
+            for (int j = 0; j < 50; j++)
+                table.update([](auto& vec){vec.push_back(200);});
+        });
+    for (auto& writer : writers)
+        writer.join();
+
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+    EXPECT_EQ(torn, 0);
+    auto last = table.load();
+    EXPECT_EQ(last.size(), 204);
+    EXPECT_EQ(std::count(last.begin(), last.end(), 200), 204);
+}
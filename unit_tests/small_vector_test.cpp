@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "small_vector.hpp"
+
+namespace
+{
+
+struct Counted
+{
+    static inline int alive;
+    static inline bool throw_on;
+    std::string str;
+
+    Counted(): Counted("") {}
+    Counted(const char* s): str {s}
+    {
+        if (throw_on)
+            throw std::exception{};
+        alive++;
+    }
+    Counted(const Counted& rhs): Counted(rhs.str.c_str()) {}
+    Counted(Counted&& rhs) noexcept: str {std::move(rhs.str)} {alive++;}
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) noexcept = default;
+    ~Counted() {alive--;}
+};
+
+} // namespace
+
+TEST(SmallVector, inlineStorage)
+{
+    static_assert(std::is_same_v<Container::SmallVector<int, 8>::iterator, Container::Vector<int>::iterator>);
+    static_assert(std::is_same_v<Container::SmallVector<int, 8>::const_reverse_iterator,
+                                 Container::Vector<int>::const_reverse_iterator>);
+
+    Container::SmallVector<int, 8> vec {};
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_EQ(vec.capacity(), 8);
+
+    auto vec_address = reinterpret_cast<const std::byte*>(&vec);
+    auto in_object = [&](const void* ptr) {
+        auto byte = static_cast<const std::byte*>(ptr);
+        return byte >= vec_address && byte < vec_address + sizeof(vec);
+    };
+
+    for (int i = 0; i < 8; i++)
+        vec.push_back(i);
+    EXPECT_EQ(vec.capacity(), 8);
+    EXPECT_TRUE(in_object(vec.data()));
+
+    vec.push_back(8);
+    EXPECT_GT(vec.capacity(), 8);
+    EXPECT_FALSE(in_object(vec.data()));
+    for (int i = 0; i < 9; i++)
+        EXPECT_EQ(vec[i], i);
+
+    vec.resize(3);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 8);
+    EXPECT_TRUE(in_object(vec.data()));
+    EXPECT_EQ(vec[2], 2);
+
+    vec.reserve(4);
+    EXPECT_EQ(vec.capacity(), 8);
+    EXPECT_TRUE(in_object(vec.data()));
+}
+
+TEST(SmallVector, constructors)
+{
+    Container::SmallVector<int, 4> vec1 (3, 7);
+    EXPECT_EQ(vec1.size(), 3);
+    EXPECT_EQ(vec1.capacity(), 4);
+
+    Container::SmallVector<int, 4> vec2 (10, 7);
+    EXPECT_EQ(vec2.size(), 10);
+    EXPECT_EQ(vec2.capacity(), 10);
+
+    Container::SmallVector<int, 4> vec3 {1, 2, 3};
+    std::vector<int> expected {1, 2, 3};
+    EXPECT_TRUE(std::equal(vec3.begin(), vec3.end(), expected.begin(), expected.end()));
+
+    Container::SmallVector<std::unique_ptr<int>, 2> vec4 (5);
+    EXPECT_EQ(vec4.size(), 5);
+    EXPECT_EQ(vec4[4].get(), nullptr);
+}
+
+TEST(SmallVector, bigFive)
+{
+    Counted::alive = 0;
+    Counted::throw_on = false;
+    if (true) {
+    Container::SmallVector<Counted, 4> small {"a", "b"};
+    Container::SmallVector<Counted, 4> big {"a", "b", "c", "d", "e", "f"};
+
+    auto small_copy = small;
+    auto big_copy = big;
+    EXPECT_EQ(small_copy[1].str, "b");
+    EXPECT_EQ(big_copy[5].str, "f");
+
+    auto big_data = big.data();
+    auto moved_big = std::move(big);
+    EXPECT_EQ(moved_big.data(), big_data);
+    EXPECT_EQ(moved_big.size(), 6);
+
+    auto moved_small = std::move(small);
+    EXPECT_EQ(moved_small.size(), 2);
+    EXPECT_EQ(moved_small[0].str, "a");
+    EXPECT_EQ(small.size(), 0);
+
+    moved_small.swap(moved_big);
+    EXPECT_EQ(moved_small.size(), 6);
+    EXPECT_EQ(moved_small.data(), big_data);
+    EXPECT_EQ(moved_big.size(), 2);
+    EXPECT_EQ(moved_big[1].str, "b");
+
+    Container::SmallVector<Counted, 4> other {"x", "y", "z"};
+    other.swap(moved_big);
+    EXPECT_EQ(other.size(), 2);
+    EXPECT_EQ(other[0].str, "a");
+    EXPECT_EQ(moved_big.size(), 3);
+    EXPECT_EQ(moved_big[2].str, "z");
+
+    other = moved_small;
+    EXPECT_EQ(other.size(), 6);
+    other = std::move(moved_big);
+    EXPECT_EQ(other.size(), 3);
+    EXPECT_EQ(other[0].str, "x");
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(SmallVector, exceptions)
+{
+    Counted::alive = 0;
+    if (true) {
+    Counted::throw_on = false;
+    Container::SmallVector<Counted, 4> vec {"a", "b", "c"};
+    Counted value {"d"};
+    Counted::throw_on = true;
+
+    auto data_before = vec.data();
+    EXPECT_ANY_THROW(vec.resize(4, value););
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec.data(), data_before);
+
+    Counted::throw_on = false;
+    vec.push_back("d");
+    vec.push_back("e");
+    Counted::throw_on = true;
+    EXPECT_ANY_THROW(vec.resize(20););
+    EXPECT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec[4].str, "e");
+    Counted::throw_on = false;
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "soa_vector.hpp"
+
+namespace
+{
+
+struct ThrowAt
+{
+    static inline int countdown;
+    static inline int alive;
+    int val;
+
+    ThrowAt(int v = 0): val {v}
+    {
+        if (--countdown == 0)
+            throw std::runtime_error{"countdown"};
+        alive++;
+    }
+    //copied, not moved, on reallocation
+    ThrowAt(const ThrowAt& rhs): ThrowAt(rhs.val) {}
+    ~ThrowAt() {alive--;}
+};
+
+using Records = Container::SoAVector<std::uint32_t, double, std::string>;
+
+} // namespace
+
+TEST(SoAVector, rowsAndColumns)
+{
+    Records vec {{1, 1.5, "one"}, {2, 2.5, "two"}};
+    for (std::uint32_t i = 3; i <= 100; i++)
+        vec.emplace_back(i, i + 0.5, std::to_string(i));
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_GE(vec.capacity(), 100);
+
+    auto ids = vec.column<0>();
+    EXPECT_EQ(ids.size(), 100);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ids.data()) % Records::column_alignment, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.column<1>().data()) % Records::column_alignment, 0);
+    EXPECT_EQ(ids[41], 42);
+    EXPECT_EQ(vec.column<2>()[99], "100");
+
+    auto [id, price, name] = vec[1];
+    EXPECT_EQ(id, 2);
+    EXPECT_EQ(price, 2.5);
+    EXPECT_EQ(name, "two");
+    name = "deux";
+    EXPECT_EQ(vec.column<2>()[1], "deux");
+
+    //rows assign through to the columns
+    vec[0] = vec[99];
+    EXPECT_TRUE(vec[0] == std::make_tuple(100u, 100.5, std::string{"100"}));
+    EXPECT_TRUE(vec.front() == vec.back());
+    Records::value_type copy = vec.at(1);
+    EXPECT_EQ(std::get<2>(copy), "deux");
+    EXPECT_THROW(vec.at(100), std::out_of_range);
+
+    //args referring to the vector itself survive the reallocation
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 100);
+    vec.emplace_back(vec.column<0>()[5], vec.column<1>()[5], vec.column<2>()[5]);
+    EXPECT_EQ(vec.back().get<2>(), "6");
+
+    std::reverse(vec.begin(), vec.end());
+    EXPECT_EQ(vec.front().get<0>(), 6);
+    EXPECT_EQ(std::count_if(vec.cbegin(), vec.cend(), [](auto row){return row.template get<1>() > 50;}), 52);
+
+    const auto& cvec = vec;
+    Records::const_iterator itr = vec.begin();
+    EXPECT_EQ((*itr).get<0>(), cvec.column<0>()[0]);
+
+    Records other (vec);
+    EXPECT_TRUE(std::equal(other.begin(), other.end(), vec.begin(), vec.end()));
+    vec.resize(3);
+    vec.resize(5, {7, 0.0, "seven"});
+    EXPECT_EQ(vec.size(), 5);
+    EXPECT_EQ(vec[4].get<2>(), "seven");
+    other = std::move(vec);
+    EXPECT_EQ(other.size(), 5);
+    EXPECT_TRUE(vec.empty());
+    other.clear();
+    EXPECT_TRUE(other.empty());
+    EXPECT_THROW(other.pop_back(), std::underflow_error);
+}
+
+TEST(SoAVector, exceptionSafety)
+{
+    ThrowAt::alive = 0;
+    ThrowAt::countdown = 0;
+    {
+        Container::SoAVector<std::string, ThrowAt, std::unique_ptr<int>> vec {};
+        for (int i = 0; i < 4; i++)
+            vec.emplace_back(std::to_string(i), ThrowAt{i}, std::make_unique<int>(i));
+        vec.shrink_to_fit();
+
+        //copying the ThrowAt column fails halfway through the reallocation
+        ThrowAt::countdown = 3;
+        EXPECT_THROW(vec.reserve(100), std::runtime_error);
+        EXPECT_EQ(vec.capacity(), 4);
+        EXPECT_EQ(ThrowAt::alive, 4);
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_EQ(vec.column<0>()[i], std::to_string(i));
+            EXPECT_EQ(vec.column<1>()[i].val, i);
+            EXPECT_EQ(*vec.column<2>()[i], i);
+        }
+
+        //the new row fails on its middle column, after the string column is built
+        ThrowAt::countdown = 1;
+        EXPECT_THROW(vec.emplace_back("4", 4, std::make_unique<int>(4)), std::runtime_error);
+        EXPECT_EQ(vec.size(), 4);
+        EXPECT_EQ(ThrowAt::alive, 4);
+
+        ThrowAt::countdown = 2;
+        EXPECT_THROW(vec.resize(10), std::runtime_error);
+        EXPECT_EQ(vec.size(), 4);
+        EXPECT_EQ(ThrowAt::alive, 4);
+
+        ThrowAt::countdown = 0;
+        vec.reserve(100);
+        EXPECT_EQ(*vec.column<2>()[3], 3);
+    }
+    EXPECT_EQ(ThrowAt::alive, 0);
+}
@@ -1,6 +1,19 @@
 #include <gtest/gtest.h>
 #include <vector>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <memory_resource>
+#include <string>
 #include "vector.hpp"
+#include "remap_allocator.hpp"
+#include "huge_page_allocator.hpp"
+#include "malloc_allocator.hpp"
+#include "aligned_allocator.hpp"
+#include "small_vector.hpp"
 
 template<typename T>
 bool vec_cmp(const Container::Vector<T>& myvec, const std::vector<T>& stdvec)
@@ -593,6 +606,612 @@ TEST(Vector, reverse_iterators)
     EXPECT_EQ(std::distance(cvec.rbegin(), cvec.rend()), cvec.size());
 }
 
+template<typename T>
+struct TrackingAllocator
+{
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap            = std::false_type;
+    using is_always_equal                        = std::false_type;
+
+    int id = 0;
+    std::shared_ptr<int> allocated = std::make_shared<int>(0);
+
+    TrackingAllocator(int id_ = 0): id {id_} {}
+    template<typename U>
+    TrackingAllocator(const TrackingAllocator<U>& rhs): id {rhs.id}, allocated {rhs.allocated} {}
+
+    T* allocate(std::size_t n)
+    {
+        *allocated += n;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* ptr, std::size_t n)
+    {
+        *allocated -= n;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template<typename U>
+    bool operator==(const TrackingAllocator<U>& rhs) const {return id == rhs.id;}
+};
+
+TEST(Vector, allocator)
+{
+    TrackingAllocator<int> alloc1 {1};
+    if (true) {
+    Container::Vector<int, TrackingAllocator<int>> vec (42, 5, alloc1);
+    EXPECT_EQ(*alloc1.allocated, 42);
+    vec.reserve(100);
+    EXPECT_EQ(*alloc1.allocated, 100);
+    vec.shrink_to_fit();
+    EXPECT_EQ(*alloc1.allocated, 42);
+    vec.resize(50);
+    EXPECT_EQ(*alloc1.allocated, 50);
+    EXPECT_EQ(vec.get_allocator().id, 1);
+    }
+    EXPECT_EQ(*alloc1.allocated, 0);
+}
+
+TEST(Vector, allocatorPropagation)
+{
+    TrackingAllocator<int> alloc1 {1}, alloc2 {2};
+    if (true) {
+    Container::Vector<int, TrackingAllocator<int>> vec1 ({1, 2, 3, 4}, alloc1);
+    Container::Vector<int, TrackingAllocator<int>> vec2 ({5, 6}, alloc2);
+
+    auto copy = vec1;
+    EXPECT_EQ(copy.get_allocator().id, 1);
+
+    vec2 = vec1;
+    EXPECT_EQ(vec2.get_allocator().id, 2);
+    EXPECT_TRUE(std::equal(vec2.begin(), vec2.end(), vec1.begin(), vec1.end()));
+
+    Container::Vector<int, TrackingAllocator<int>> vec3 ({7, 8, 9}, alloc2);
+    auto data_before = vec1.data();
+    vec3 = std::move(vec1);
+    EXPECT_EQ(vec3.get_allocator().id, 2);
+    EXPECT_NE(vec3.data(), data_before);
+    EXPECT_EQ(vec3.size(), 4);
+    EXPECT_EQ(vec3[3], 4);
+
+    Container::Vector<int, TrackingAllocator<int>> vec4 ({7, 8, 9}, alloc1);
+    data_before = copy.data();
+    vec4 = std::move(copy);
+    EXPECT_EQ(vec4.data(), data_before);
+
+    Container::Vector<int, TrackingAllocator<int>> vec5 (std::move(vec4), alloc2);
+    EXPECT_NE(vec5.data(), data_before);
+    EXPECT_EQ(vec5.size(), 4);
+    EXPECT_EQ(vec5.get_allocator().id, 2);
+    }
+    EXPECT_EQ(*alloc1.allocated, 0);
+    EXPECT_EQ(*alloc2.allocated, 0);
+}
+
+TEST(Vector, pmr)
+{
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource resource {buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+    Container::pmr::Vector<int> vec {&resource};
+    for (int i = 0; i < 100; i++)
+        vec.push_back(i);
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(vec.get_allocator().resource(), &resource);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(vec[i], i);
+
+    auto copy = vec;
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+
+    Container::pmr::Vector<std::pmr::string> strings {&resource};
+    strings.push_back(std::pmr::string{"a string long enough to avoid small string optimization"});
+    strings.resize(4);
+    EXPECT_EQ(strings[0].get_allocator().resource(), &resource);
+    EXPECT_EQ(strings[3].get_allocator().resource(), &resource);
+}
+
+struct Relocatable
+{
+    static inline int moves;
+    static inline int destroyed;
+    int value = 0;
+
+    Relocatable(int val = 0): value {val} {}
+    Relocatable(const Relocatable&) = default;
+    Relocatable(Relocatable&& rhs) noexcept: value {rhs.value} {moves++;}
+    ~Relocatable() {destroyed++;}
+};
+
+template<>
+struct Ranges::is_trivially_relocatable<Relocatable>: std::true_type {};
+
+TEST(Vector, relocation)
+{
+    static_assert(Ranges::is_trivially_relocatable_v<int>);
+    static_assert(Ranges::is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(!Ranges::is_trivially_relocatable_v<Throwable>);
+    static_assert(!Ranges::is_trivially_relocatable_v<std::unique_ptr<int, std::function<void(int*)>>>);
+
+    Container::Vector<Relocatable> vec {};
+    for (int i = 0; i < 100; i++)
+        vec.push_back(Relocatable{i});
+
+    Relocatable::moves = 0;
+    Relocatable::destroyed = 0;
+    vec.reserve(1000);
+    vec.shrink_to_fit();
+    vec.resize(200, Relocatable{42});
+    EXPECT_EQ(Relocatable::moves, 0);
+    EXPECT_EQ(Relocatable::destroyed, 1);
+
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(vec[i].value, i);
+    for (int i = 100; i < 200; i++)
+        EXPECT_EQ(vec[i].value, 42);
+}
+
+TEST(Vector, relocationExceptions)
+{
+    ThrowCopyable::a = 0;
+    if (true) {
+    ThrowCopyable::throw_on = false;
+    Container::Vector<ThrowCopyable> vec (42);
+    ThrowCopyable::throw_on = true;
+
+    auto data_before = vec.data();
+    EXPECT_ANY_THROW(vec.resize(100););
+    EXPECT_EQ(vec.data(), data_before);
+    EXPECT_EQ(vec.size(), 42);
+    EXPECT_EQ(vec.capacity(), 42);
+    for (int i = 0; i < 42; i++)
+        EXPECT_EQ(vec[i].vec.size(), 7);
+    }
+    EXPECT_EQ(ThrowCopyable::a, 0);
+
+    Throwable::a = 0;
+    if (true) {
+    Throwable::throw_on = false;
+    Container::Vector<Throwable> vec (30);
+    Throwable::throw_on = true;
+
+    EXPECT_ANY_THROW(vec.reserve(100););
+    EXPECT_EQ(vec.size(), 30);
+    EXPECT_EQ(vec.capacity(), 30);
+    for (int i = 0; i < 30; i++)
+        EXPECT_EQ(vec[i].vec.size(), 7);
+    }
+    EXPECT_EQ(Throwable::a, 0);
+}
+
+TEST(Vector, remapAllocator)
+{
+    using Alloc = Container::RemapAllocator<std::uint64_t, 4096>;
+    Container::Vector<std::uint64_t, Alloc> vec {};
+    for (std::uint64_t i = 0; i < 10000; i++)
+        vec.push_back(i);
+    EXPECT_EQ(vec.size(), 10000);
+    for (std::uint64_t i = 0; i < 10000; i++)
+        EXPECT_EQ(vec[i], i);
+
+    vec.resize(20000, 42);
+    EXPECT_EQ(vec.capacity(), 20000);
+    EXPECT_EQ(vec[9999], 9999);
+    EXPECT_EQ(vec[19999], 42);
+
+    vec.resize(100);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 100);
+    for (std::uint64_t i = 0; i < 100; i++)
+        EXPECT_EQ(vec[i], i);
+
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 0);
+    EXPECT_EQ(vec.data(), nullptr);
+
+    auto copy = Container::Vector<std::uint64_t, Alloc>(1000, 7);
+    vec = copy;
+    vec.reserve(5000);
+    EXPECT_EQ(vec.size(), 1000);
+    EXPECT_EQ(vec[999], 7);
+}
+
+//counts the blocks grown in place, every other allocator call is RemapAllocator's
+struct CountingRemapAllocator : Container::RemapAllocator<std::uint64_t, 4096>
+{
+    static inline int reallocations;
+
+    std::uint64_t* reallocate(std::uint64_t* ptr, std::size_t old_n, std::size_t new_n)
+    {
+        reallocations++;
+        return RemapAllocator::reallocate(ptr, old_n, new_n);
+    }
+};
+
+TEST(Vector, remapAllocatorGrowth)
+{
+    Container::Vector<std::uint64_t, CountingRemapAllocator> vec {};
+    vec.push_back(0);
+    CountingRemapAllocator::reallocations = 0;
+    for (std::uint64_t i = 1; i < 10000; i++)
+        vec.push_back(i);
+    EXPECT_GT(CountingRemapAllocator::reallocations, 0);
+    auto grown = CountingRemapAllocator::reallocations;
+
+    vec.shrink_to_fit();
+    vec.emplace_back(vec[5]);
+    EXPECT_EQ(CountingRemapAllocator::reallocations, grown + 2);
+    vec.insert(vec.end(), vec.capacity() - vec.size() + 99, vec[7]);
+    EXPECT_EQ(CountingRemapAllocator::reallocations, grown + 3);
+    EXPECT_EQ(vec[10000], 5);
+    EXPECT_EQ(vec[10001], 7);
+    EXPECT_EQ(vec.back(), 7);
+    for (std::uint64_t i = 0; i < 10000; i++)
+        ASSERT_EQ(vec[i], i);
+
+    //the fill value may be an element of the block that is grown
+    Container::Vector<std::uint64_t, CountingRemapAllocator> aliased {41, 42, 43, 44};
+    aliased.shrink_to_fit();
+    grown = CountingRemapAllocator::reallocations;
+    aliased.resize(5000, aliased[1]);
+    EXPECT_EQ(CountingRemapAllocator::reallocations, grown + 1);
+    EXPECT_EQ(aliased[3], 44);
+    EXPECT_EQ(aliased[4], 42);
+    EXPECT_EQ(aliased[4999], 42);
+}
+
+TEST(Vector, hugePageAllocator)
+{
+    using Alloc = Container::HugePageAllocator<std::uint64_t, 4096>;
+    Container::Vector<std::uint64_t, Alloc> vec {};
+    for (std::uint64_t i = 0; i < 100000; i++)
+        vec.push_back(i);
+    auto huge_page = Container::os::huge_page_size();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % huge_page, 0);
+    for (std::uint64_t i = 0; i < 100000; i++)
+        EXPECT_EQ(vec[i], i);
+
+    //the dropped tail faults back in when the vector grows again
+    vec.resize(10);
+    vec.resize(100000, 42);
+    for (std::uint64_t i = 0; i < 10; i++)
+        EXPECT_EQ(vec[i], i);
+    EXPECT_EQ(vec[10], 42);
+    EXPECT_EQ(vec[99999], 42);
+
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 0);
+
+    Container::Vector<std::uint64_t, Alloc> small (10, 1);
+    small.resize(1);
+    EXPECT_EQ(small[0], 1);
+
+    //whole huge pages past the first element are dropped, whichever kind the block is mapped on
+    Alloc alloc;
+    auto count = 3 * huge_page / sizeof(std::uint64_t);
+    auto block = alloc.allocate(count);
+    std::fill(block, block + count, 5);
+    EXPECT_TRUE(alloc.release_unused(block, count, 1));
+    EXPECT_EQ(block[0], 5);
+    EXPECT_EQ(block[count - 1], 0);
+    alloc.deallocate(block, count);
+}
+
+TEST(Vector, emplace_back)
+{
+    Container::Vector<std::string> vec {};
+    vec.emplace_back(5, 'a');
+    EXPECT_EQ(vec.back(), "aaaaa");
+    EXPECT_EQ(vec.emplace_back("b"), "b");
+
+    vec.shrink_to_fit();
+    ASSERT_EQ(vec.size(), vec.capacity());
+    vec.emplace_back(vec[0]);
+    EXPECT_EQ(vec[2], "aaaaa");
+    vec.push_back(vec[1]);
+    EXPECT_EQ(vec[3], "b");
+
+    Container::Vector<std::unique_ptr<int>> ptrs {};
+    ptrs.emplace_back(new int {42});
+    EXPECT_EQ(*ptrs.back(), 42);
+}
+
+TEST(Vector, insert)
+{
+    Container::Vector<std::string> vec {"a", "b", "c"};
+    std::vector<std::string> expected {"a", "b", "c"};
+
+    auto itr = vec.insert(vec.begin() + 1, "x");
+    expected.insert(expected.begin() + 1, "x");
+    EXPECT_EQ(*itr, "x");
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+
+    vec.reserve(100);
+    itr = vec.insert(vec.begin(), 3, vec[2]);
+    expected.insert(expected.begin(), 3, expected[2]);
+    EXPECT_EQ(*itr, "b");
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+
+    std::vector<std::string> range {"r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9"};
+    vec.insert(vec.end() - 2, range.begin(), range.end());
+    expected.insert(expected.end() - 2, range.begin(), range.end());
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+
+    vec.insert(vec.begin() + 3, range.begin(), range.begin() + 2);
+    expected.insert(expected.begin() + 3, range.begin(), range.begin() + 2);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+
+    vec.shrink_to_fit();
+    vec.insert(vec.begin() + 1, {"i1", "i2"});
+    expected.insert(expected.begin() + 1, {"i1", "i2"});
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+
+    vec.emplace(vec.begin() + 4, 2, 'e');
+    expected.emplace(expected.begin() + 4, 2, 'e');
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+
+    std::istringstream stream {"s1 s2 s3"};
+    vec.insert(vec.begin() + 2, std::istream_iterator<std::string>{stream}, std::istream_iterator<std::string>{});
+    expected.insert(expected.begin() + 2, {"s1", "s2", "s3"});
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+}
+
+TEST(Vector, insertBeforeLast)
+{
+    //the new element lands in the last slot, no live element is moved past the old end
+    Container::Vector<std::string> vec {"a", "b"};
+    vec.reserve(10);
+    vec.emplace(vec.begin() + 1, "x");
+    EXPECT_TRUE(vec_cmp(vec, std::vector<std::string>{"a", "x", "b"}));
+
+    std::string str {"y"};
+    vec.insert(vec.begin() + 2, str);
+    EXPECT_TRUE(vec_cmp(vec, std::vector<std::string>{"a", "x", "y", "b"}));
+    vec.insert(vec.end() - 1, std::string{"z"});
+    EXPECT_TRUE(vec_cmp(vec, std::vector<std::string>{"a", "x", "y", "z", "b"}));
+    EXPECT_EQ(str, "y");
+}
+
+TEST(Vector, insertTrivial)
+{
+    Container::Vector<int> vec {0, 1, 2, 3, 4};
+    std::vector<int> expected {0, 1, 2, 3, 4};
+    vec.reserve(50);
+
+    vec.insert(vec.begin() + 2, 3, vec[4]);
+    expected.insert(expected.begin() + 2, 3, expected[4]);
+    EXPECT_TRUE(vec_cmp(vec, expected));
+
+    vec.emplace(vec.begin(), vec[1]);
+    expected.emplace(expected.begin(), expected[1]);
+    EXPECT_TRUE(vec_cmp(vec, expected));
+
+    std::vector<int> head (expected.begin(), expected.begin() + 9);
+    vec.insert(vec.end(), head.begin(), head.end());
+    expected.insert(expected.end(), head.begin(), head.end());
+    EXPECT_TRUE(vec_cmp(vec, expected));
+
+    Container::Vector<Relocatable> relocatable (10);
+    relocatable.insert(relocatable.begin(), 5, Relocatable{1});
+    relocatable.reserve(100);
+    Relocatable::moves = 0;
+    relocatable.insert(relocatable.begin() + 1, Relocatable{2});
+    EXPECT_EQ(Relocatable::moves, 2);
+    EXPECT_EQ(relocatable.size(), 16);
+    EXPECT_EQ(relocatable[1].value, 2);
+}
+
+TEST(Vector, insertExceptions)
+{
+    Throwable::a = 0;
+    if (true) {
+    Throwable::throw_on = false;
+    Container::Vector<Throwable> vec (30);
+    Throwable::throw_on = true;
+
+    auto data_before = vec.data();
+    EXPECT_ANY_THROW(vec.insert(vec.begin() + 10, 30, Throwable{}););
+    EXPECT_EQ(vec.data(), data_before);
+    EXPECT_EQ(vec.size(), 30);
+    EXPECT_EQ(vec.capacity(), 30);
+    for (int i = 0; i < 30; i++)
+        EXPECT_EQ(vec[i].vec.size(), 7);
+    Throwable::throw_on = false;
+    }
+    EXPECT_EQ(Throwable::a, 0);
+}
+
+TEST(Vector, erase)
+{
+    Container::Vector<std::string> vec {"a", "b", "c", "d", "e", "f"};
+    std::vector<std::string> expected {"a", "b", "c", "d", "e", "f"};
+
+    auto itr = vec.erase(vec.begin() + 1);
+    expected.erase(expected.begin() + 1);
+    EXPECT_EQ(*itr, "c");
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+
+    itr = vec.erase(vec.begin() + 1, vec.begin() + 3);
+    expected.erase(expected.begin() + 1, expected.begin() + 3);
+    EXPECT_EQ(*itr, "e");
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+
+    itr = vec.erase(vec.begin(), vec.end());
+    EXPECT_EQ(itr, vec.end());
+    EXPECT_TRUE(vec.empty());
+
+    Container::Vector<std::unique_ptr<int>> ptrs {};
+    for (int i = 0; i < 10; i++)
+        ptrs.push_back(std::make_unique<int>(i));
+    ptrs.erase(ptrs.begin() + 2, ptrs.begin() + 5);
+    EXPECT_EQ(ptrs.size(), 7);
+    EXPECT_EQ(*ptrs[2], 5);
+    EXPECT_EQ(*ptrs[6], 9);
+}
+
+TEST(Vector, swap_remove)
+{
+    Container::Vector<int> vec {0, 1, 2, 3, 4};
+    auto itr = vec.swap_remove(vec.begin() + 1);
+    EXPECT_EQ(*itr, 4);
+    EXPECT_TRUE(vec_cmp(vec, std::vector<int>{0, 4, 2, 3}));
+
+    itr = vec.swap_remove(vec.end() - 1);
+    EXPECT_EQ(itr, vec.end());
+    EXPECT_TRUE(vec_cmp(vec, std::vector<int>{0, 4, 2}));
+}
+
+TEST(Vector, resize_for_overwrite)
+{
+    Container::Vector<unsigned char> vec (64, 0xAB);
+    vec.resize(0);
+    vec.resize_for_overwrite(64);
+    EXPECT_EQ(vec.size(), 64);
+    EXPECT_EQ(vec.capacity(), 64);
+    for (auto byte : vec)
+        EXPECT_EQ(byte, 0xAB);
+
+    vec.resize_for_overwrite(128);
+    EXPECT_EQ(vec.size(), 128);
+    EXPECT_EQ(vec[63], 0xAB);
+
+    Container::Vector<std::string> strings (3, Container::default_init);
+    EXPECT_EQ(strings.size(), 3);
+    EXPECT_TRUE(strings[2].empty());
+    strings.resize_for_overwrite(5);
+    EXPECT_TRUE(strings[4].empty());
+
+    Container::Vector<int> ints (100, Container::default_init);
+    EXPECT_EQ(ints.size(), 100);
+}
+
+TEST(Vector, resize_and_overwrite)
+{
+    Container::Vector<char> buf {'a', 'b'};
+    buf.resize_and_overwrite(100, [](char* data, std::size_t count)
+    {
+        EXPECT_EQ(count, 100);
+        EXPECT_EQ(data[1], 'b');
+        std::memcpy(data + 2, "cde", 3);
+        return 5;
+    });
+    EXPECT_EQ(buf.size(), 5);
+    EXPECT_GE(buf.capacity(), 100);
+    EXPECT_EQ(std::string(buf.begin(), buf.end()), "abcde");
+
+    buf.resize_and_overwrite(3, [](char*, std::size_t){return 1;});
+    EXPECT_EQ(buf.size(), 1);
+    EXPECT_EQ(buf[0], 'a');
+
+    EXPECT_ANY_THROW(buf.resize_and_overwrite(10, [](char*, std::size_t) -> std::size_t {throw std::exception{};}););
+    EXPECT_EQ(buf.size(), 1);
+    EXPECT_ANY_THROW(buf.resize_and_overwrite(10, [](char*, std::size_t){return 11;}););
+    EXPECT_EQ(buf.size(), 1);
+
+    Container::Vector<std::string> strings {"a"};
+    strings.resize_and_overwrite(4, [](std::string* data, std::size_t count)
+    {
+        for (std::size_t i = 1; i < count; i++)
+            data[i] = std::string(i, 'x');
+        return count - 1;
+    });
+    EXPECT_EQ(strings.size(), 3);
+    EXPECT_EQ(strings[0], "a");
+    EXPECT_EQ(strings[2], "xx");
+}
+
+template<typename Vec>
+std::vector<std::size_t> capacity_ladder(std::size_t n)
+{
+    Vec vec {};
+    std::vector<std::size_t> ladder {};
+    for (std::size_t i = 0; i < n; i++)
+    {
+        vec.push_back(typename Vec::value_type{});
+        if (ladder.empty() || ladder.back() != vec.capacity())
+            ladder.push_back(vec.capacity());
+    }
+    return ladder;
+}
+
+TEST(Vector, growthPolicy)
+{
+    using Doubling = Container::Vector<int>;
+    using OneAndHalf = Container::Vector<int, std::allocator<int>, Container::Growth::OneAndHalf>;
+    EXPECT_EQ(capacity_ladder<Doubling>(50), (std::vector<std::size_t>{1, 3, 7, 15, 31, 63}));
+    EXPECT_EQ(capacity_ladder<OneAndHalf>(50), (std::vector<std::size_t>{1, 2, 4, 7, 11, 17, 26, 40, 61}));
+
+    using PageRounded = Container::Vector<int, std::allocator<int>, Container::Growth::PageRounded<>>;
+    for (auto capacity : capacity_ladder<PageRounded>(10000))
+    {
+        if (capacity * sizeof(int) >= 4096)
+        {
+            EXPECT_EQ(capacity * sizeof(int) % 4096, 0);
+        }
+    }
+
+    using Usable = Container::Vector<double, Container::MallocAllocator<double>, Container::Growth::UsableSize<>>;
+    Usable vec {};
+    for (int i = 0; i < 1000; i++)
+    {
+        vec.push_back(i);
+        EXPECT_EQ(vec.capacity(), ::malloc_usable_size(vec.data()) / sizeof(double));
+    }
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(vec[i], i);
+
+    Container::Vector<double, Container::MallocAllocator<double>> exact {};
+    exact.reserve(3);
+    EXPECT_EQ(exact.capacity(), 3);
+}
+
+struct alignas(64) CacheLine
+{
+    int value = 0;
+};
+
+template<typename Vec>
+bool is_aligned(const Vec& vec, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(vec.data()) % alignment == 0;
+}
+
+TEST(Vector, overAligned)
+{
+    Container::Vector<CacheLine> vec {};
+    for (int i = 0; i < 100; i++)
+    {
+        vec.push_back(CacheLine{i});
+        EXPECT_TRUE(is_aligned(vec, 64));
+    }
+    vec.shrink_to_fit();
+    EXPECT_TRUE(is_aligned(vec, 64));
+    EXPECT_EQ(vec[99].value, 99);
+
+    Container::SmallVector<CacheLine, 4> small {};
+    small.emplace_back();
+    EXPECT_TRUE(is_aligned(small, 64));
+
+    Container::AlignedVector<float> floats {};
+    for (int i = 0; i < 100; i++)
+    {
+        floats.push_back(i);
+        EXPECT_TRUE(is_aligned(floats, 64));
+    }
+    Container::AlignedVector<double, 32> doubles (17, 1.5);
+    EXPECT_TRUE(is_aligned(doubles, 32));
+    doubles.resize(1000);
+    EXPECT_TRUE(is_aligned(doubles, 32));
+    EXPECT_EQ(doubles[16], 1.5);
+
+    Container::AlignedVector<CacheLine, 16> lines (3);
+    EXPECT_TRUE(is_aligned(lines, 64));
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);